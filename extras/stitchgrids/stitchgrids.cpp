@@ -10,6 +10,7 @@
 #include <random>
 #include <Argos/Argos.hpp>
 #include <GridLib/MultiGridReader.hpp>
+#include <GridLib/MultiGridTileIterator.hpp>
 #include <GridLib/Rasterize.hpp>
 #include <GridLib/ReadGrid.hpp>
 #include <GridLib/WriteJsonGrid.hpp>
@@ -88,10 +89,7 @@ int main(int argc, char* argv[])
         const auto filenames = get_filenames(args.values("FILE").as_strings());
 
         GridLib::MultiGridReader reader;
-        for (const auto& filename : filenames)
-        {
-            reader.read_grid(filename);
-        }
+        reader.read_grids(filenames);
 
         auto tile_arg = args.value("--tile")
             .split_n('x', 2)
@@ -100,32 +98,27 @@ int main(int argc, char* argv[])
         fs::path filename(args.value("--output").as_string());
         const auto extension = filename.extension();
 
-        auto total_size = reader.size();
-        for (size_t row = 0; row < total_size.rows; row += tile_size.rows)
+        GridLib::MultiGridTileIterator tiles(reader, tile_size);
+        while (tiles.next())
         {
-            for (size_t col = 0; col < total_size.columns; col += tile_size.columns)
+            const auto& grid = tiles.grid();
+            auto grid_name = filename;
+            if (!grid_name.empty())
+            {
+                const auto [row, col] = tiles.extent().origin;
+                grid_name.replace_extension("")
+                    .concat("_" + std::to_string(row) + "_" + std::to_string(col))
+                    .replace_extension(extension);
+            }
+            if (extension == ".png")
+            {
+                const auto index_mode = GridLib::get_index_mode_for_top_left_origin(
+                    grid.spatial_info());
+                write_png(grid_name, grid, index_mode);
+            }
+            else
             {
-                const auto extent = GridLib::Extent({row, col}, tile_size);
-                if (!reader.has_data(extent))
-                    continue;
-                const auto grid = reader.get_grid(extent);
-                auto grid_name = filename;
-                if (!grid_name.empty())
-                {
-                    grid_name.replace_extension("")
-                        .concat("_" + std::to_string(row) + "_" + std::to_string(col))
-                        .replace_extension(extension);
-                }
-                if (extension == ".png")
-                {
-                    const auto index_mode = GridLib::get_index_mode_for_top_left_origin(
-                        grid.spatial_info());
-                    write_png(grid_name, grid, index_mode);
-                }
-                else
-                {
-                    write_json(filename, grid);
-                }
+                write_json(grid_name, grid);
             }
         }
     }
@@ -0,0 +1,22 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "IGrid.hpp"
+
+namespace GridLib
+{
+    /**
+     * @brief The size and spatial information of a grid, without its
+     *  elevations.
+     */
+    struct GridInfo
+    {
+        Size size;
+        SpatialInfo spatial_info;
+    };
+}
@@ -8,8 +8,10 @@
 #pragma once
 #include <filesystem>
 #include <memory>
+#include <span>
 
 #include "Grid.hpp"
+#include "GridInfo.hpp"
 #include "ReadGrid.hpp"
 
 namespace GridLib
@@ -20,10 +22,97 @@ namespace GridLib
     using SignedExtent = Chorasmia::Extent2D<int64_t>;
     struct GridData;
 
+    /**
+     * @brief Determines how MultiGridReader stores the grids that are
+     *  added to it.
+     */
+    enum class MultiGridStorage
+    {
+        /**
+         * @brief Grids are written to a temporary file and read back with
+         *  regular file I/O.
+         */
+        TEMPORARY_FILE,
+        /**
+         * @brief Grids are written to a temporary file that is memory
+         *  mapped, only the rows that are requested are copied.
+         */
+        MEMORY_MAPPED_FILE,
+        /**
+         * @brief Only the size and spatial information of grids read from
+         *  files is read up front, the grids are decoded from their files
+         *  when get_grid needs them.
+         *
+         * Grids that aren't read from files are stored in a temporary
+         * file.
+         */
+        SOURCE_FILES,
+        /**
+         * @brief Grids are split into blocks that are compressed and
+         *  written to a temporary file.
+         *
+         * Only the blocks that overlap the requested extent are read and
+         * decompressed. The cache holds decompressed blocks rather than
+         * entire grids.
+         */
+        COMPRESSED_FILE
+    };
+
+    /**
+     * @brief Determines how MultiGridReader combines the values of grids
+     *  that overlap.
+     *
+     * UNKNOWN_ELEVATION never replaces a known elevation, regardless of
+     * the policy.
+     */
+    enum class MultiGridMergePolicy
+    {
+        /**
+         * @brief The value from the grid that was added last is used.
+         */
+        LAST_WINS,
+        /**
+         * @brief The value from the grid that was added first is used.
+         */
+        FIRST_WINS,
+        /**
+         * @brief The mean of the known values is used.
+         */
+        MEAN,
+        /**
+         * @brief The largest of the known values is used.
+         */
+        MAX
+    };
+
+    /**
+     * @brief Counters for MultiGridReader's cache of decoded grids.
+     */
+    struct MultiGridCacheStatistics
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        /**
+         * @brief The number of bytes currently held by the cache.
+         */
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+
+    /**
+     * @brief Assembles grids that share a coordinate system into a
+     *  single large grid that can be read piecewise.
+     *
+     * has_data() and get_grid() can be called concurrently from several
+     * threads, but not concurrently with any of the non-const member
+     * functions.
+     */
     class MultiGridReader
     {
     public:
-        MultiGridReader();
+        explicit MultiGridReader(MultiGridStorage storage
+                                     = MultiGridStorage::MEMORY_MAPPED_FILE);
 
         ~MultiGridReader();
 
@@ -31,25 +120,132 @@ namespace GridLib
 
         MultiGridReader& operator=(MultiGridReader&& other) noexcept;
 
+        [[nodiscard]] MultiGridStorage storage() const;
+
         [[nodiscard]] Size size() const;
 
+        /**
+         * @brief Returns the number of bytes the grids occupy in the
+         *  temporary file.
+         */
+        [[nodiscard]] uint64_t storage_size() const;
+
+        /**
+         * @brief Returns the maximum number of bytes in the cache of
+         *  decoded grids.
+         */
+        [[nodiscard]] size_t cache_capacity() const;
+
+        /**
+         * @brief Sets the maximum number of bytes in the cache of decoded
+         *  grids. A capacity of 0 disables the cache.
+         *
+         * The cache holds grids that are decoded from source files, or
+         * read from the temporary file when the storage is
+         * MultiGridStorage::TEMPORARY_FILE or
+         * MultiGridStorage::COMPRESSED_FILE. Memory mapped grids are
+         * never cached.
+         */
+        void set_cache_capacity(size_t capacity);
+
+        [[nodiscard]] MultiGridCacheStatistics cache_statistics() const;
+
+        [[nodiscard]] MultiGridMergePolicy merge_policy() const;
+
+        /**
+         * @brief Sets how the values of overlapping grids are combined.
+         *
+         * The default is MultiGridMergePolicy::LAST_WINS.
+         */
+        void set_merge_policy(MultiGridMergePolicy policy);
+
         void read_grid(const std::filesystem::path& filename);
 
         void read_grid(const void* buffer, size_t size, GridFileType file_type);
 
+        /**
+         * @brief Reads the grids in @a filenames, decoding up to
+         *  @a thread_count files in parallel.
+         *
+         * The grids are added in the order of @a filenames, the result is
+         * the same as calling read_grid() for each file. A
+         * @a thread_count of 0 uses the number of hardware threads.
+         */
+        void read_grids(std::span<const std::filesystem::path> filenames,
+                        unsigned thread_count = 0);
+
         void add_grid(const Grid& grid, const std::filesystem::path& filename = {});
 
         [[nodiscard]] bool has_data(Extent extent) const;
 
         [[nodiscard]] Grid get_grid(Extent extent) const;
+
+        /**
+         * @brief Reads the grid in @a extent into @a result.
+         *
+         * @a result is resized to the size of @a extent after it has been
+         * clamped to the reader's size. The memory in @a result is
+         * reused, repeated calls with extents of the same size don't
+         * allocate unless grids must be loaded into the cache.
+         */
+        void get_grid_into(Extent extent, Grid& result) const;
+
+        /**
+         * @brief Reads the elevations in @a extent into @a values.
+         *
+         * @a values must have the size of @a extent after it has been
+         * clamped to the reader's size.
+         */
+        void get_grid_into(Extent extent,
+                           Chorasmia::MutableArrayView2D<float> values) const;
+
+        /**
+         * @brief Returns the extents of the tiles of size @a tile_size
+         *  that intersect at least one grid, in row-major order.
+         *
+         * The tiles are aligned with the reader's origin, tiles along
+         * the lower and right edges are clamped to the reader's size.
+         */
+        [[nodiscard]]
+        std::vector<Extent> get_tiles_with_data(const Size& tile_size) const;
     private:
         void assert_data() const;
 
-        void assert_compatible_grid(const Grid& grid) const;
+        void assert_compatible_grid(const SpatialInfo& spatial_info) const;
+
+        [[nodiscard]]
+        SignedIndex get_insertion_point(const SpatialInfo& spatial_info) const;
+
+        void add_grid_info(GridInfo info, const std::filesystem::path& filename);
+
+        void add_grid_data(GridData grid_data);
+
+        [[nodiscard]]
+        Chorasmia::Array2D<float> load_grid_values(const GridData& grid_data) const;
+
+        [[nodiscard]] SignedExtent get_internal_extent(Extent extent) const;
+
+        void assign_spatial_info(const SignedExtent& extent,
+                                 SpatialInfo& spatial_info) const;
+
+        void copy_values(const SignedExtent& extent,
+                         Chorasmia::MutableArrayView2D<float> values) const;
+
+        struct MergeTarget;
+
+        void load_and_merge_blocks(const MergeTarget& target,
+                                   const GridData& grid_data,
+                                   const Extent& src_extent,
+                                   const Index& dst_start) const;
+
+        void read_block(const GridData& grid_data,
+                        size_t block_index,
+                        std::span<float> values) const;
 
-        void load_and_copy_grid_data(Grid& result,
-                                     const GridData& grid_data,
-                                     const SignedExtent& extent) const;
+        void load_and_copy_grid_data(
+            const MergeTarget& target,
+            const GridData& grid_data,
+            const SignedExtent& extent) const;
 
         struct Data;
         std::unique_ptr<Data> data_;
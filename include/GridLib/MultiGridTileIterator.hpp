@@ -0,0 +1,64 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <vector>
+#include "MultiGridReader.hpp"
+
+namespace GridLib
+{
+    /**
+     * @brief Iterates over the tiles of a MultiGridReader that contain
+     *  data.
+     *
+     * The reader's extent is divided into tiles of a given size, tiles
+     * that don't intersect any of the reader's grids are skipped without
+     * being read. The same Grid is reused for every tile unless the
+     * caller moves it out of the iterator.
+     *
+     * @code
+     * MultiGridTileIterator it(reader, {1000, 1000});
+     * while (it.next())
+     *     process(it.extent(), it.grid());
+     * @endcode
+     */
+    class MultiGridTileIterator
+    {
+    public:
+        MultiGridTileIterator(const MultiGridReader& reader, const Size& tile_size);
+
+        /**
+         * @brief Reads the next tile that contains data.
+         *
+         * Returns false when there are no more tiles.
+         */
+        bool next();
+
+        /**
+         * @brief Returns the current tile's extent within the reader.
+         *
+         * Tiles along the lower and right edges of the reader can be
+         * smaller than the tile size.
+         */
+        [[nodiscard]] const Extent& extent() const;
+
+        [[nodiscard]] const Grid& grid() const;
+
+        [[nodiscard]] Grid& grid();
+
+        /**
+         * @brief Returns the number of tiles that contain data.
+         */
+        [[nodiscard]] size_t tile_count() const;
+    private:
+        const MultiGridReader* reader_;
+        std::vector<Extent> extents_;
+        size_t next_index_ = 0;
+        Extent extent_;
+        Grid grid_;
+    };
+}
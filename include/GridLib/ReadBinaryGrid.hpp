@@ -0,0 +1,78 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+
+#include "Grid.hpp"
+#include "GridInfo.hpp"
+
+namespace GridLib
+{
+    Grid read_binary_grid(std::istream& stream);
+
+    Grid read_binary_grid(const void* buffer, size_t size);
+
+    Grid read_binary_grid(const std::filesystem::path& filename);
+
+    /**
+     * @brief Reads the size and spatial information of a binary grid,
+     *  the elevations are skipped.
+     */
+    GridInfo read_binary_grid_info(const std::filesystem::path& filename);
+
+    [[nodiscard]] bool is_binary_grid(const std::filesystem::path& filename);
+
+    [[nodiscard]] bool is_binary_grid(const void* buffer, size_t size);
+
+    /**
+     * @brief A binary grid file that is memory-mapped rather than read.
+     *
+     * Opening a MappedGrid only parses the file's header, the elevations
+     * are read directly from the mapping as they are accessed. Views and
+     * subgrids remain valid as long as the MappedGrid exists.
+     */
+    class MappedGrid : public IGrid
+    {
+    public:
+        MappedGrid();
+
+        explicit MappedGrid(const std::filesystem::path& filename);
+
+        MappedGrid(MappedGrid&& other) noexcept;
+
+        ~MappedGrid() override;
+
+        MappedGrid& operator=(MappedGrid&& other) noexcept;
+
+        [[nodiscard]]
+        bool empty() const;
+
+        [[nodiscard]]
+        GridView view() const;
+
+        [[nodiscard]]
+        Size size() const override;
+
+        [[nodiscard]]
+        Xyz::Vector2D tie_point() const override;
+
+        [[nodiscard]]
+        const SpatialInfo& spatial_info() const override;
+
+        [[nodiscard]]
+        Chorasmia::ArrayView2D<float> values() const override;
+
+        [[nodiscard]]
+        GridView subgrid(const Index& index, const Size& size) const override;
+
+    private:
+        struct Data;
+        std::unique_ptr<Data> data_;
+    };
+}
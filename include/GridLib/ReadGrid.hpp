@@ -9,6 +9,7 @@
 #include <filesystem>
 
 #include "Grid.hpp"
+#include "GridInfo.hpp"
 
 namespace GridLib
 {
@@ -18,6 +19,8 @@ namespace GridLib
         DEM,
         GEOTIFF,
         GRIDLIB_JSON,
+        GRIDLIB_BINARY,
+        GRIDLIB_UBJSON,
         AUTO_DETECT
     };
 
@@ -29,4 +32,14 @@ namespace GridLib
 
     Grid read_grid(const std::filesystem::path& filename,
                    GridFileType type = GridFileType::AUTO_DETECT);
+
+    /**
+     * @brief Reads the size and spatial information of the grid in
+     *  @a filename.
+     *
+     * The elevations are neither parsed nor decoded, GeoTIFF and DEM files
+     * only have their headers read.
+     */
+    GridInfo read_grid_info(const std::filesystem::path& filename,
+                            GridFileType type = GridFileType::AUTO_DETECT);
 }
@@ -9,6 +9,12 @@
 #include <filesystem>
 
 #include "Grid.hpp"
+#include "GridInfo.hpp"
+
+namespace Yson
+{
+    class Reader;
+}
 
 namespace GridLib
 {
@@ -17,4 +23,17 @@ namespace GridLib
     Grid read_json_grid(const std::filesystem::path& filename, bool strict = false);
 
     Grid read_json_grid(const void* buffer, size_t size, bool strict = false);
+
+    /**
+     * @brief Reads the size and spatial information of a JSON grid,
+     *  the elevations are skipped.
+     */
+    GridInfo read_json_grid_info(const std::filesystem::path& filename,
+                                 bool strict = false);
+
+    /**
+     * @brief Reads spatial information written by
+     *  write_json(Yson::Writer&, const SpatialInfo&).
+     */
+    SpatialInfo read_model(Yson::Reader& reader, bool strict = false);
 }
@@ -0,0 +1,32 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+
+#include "Grid.hpp"
+#include "GridInfo.hpp"
+
+namespace GridLib
+{
+    Grid read_ubjson_grid(std::istream& stream, bool strict = false);
+
+    Grid read_ubjson_grid(const std::filesystem::path& filename, bool strict = false);
+
+    Grid read_ubjson_grid(const void* buffer, size_t size, bool strict = false);
+
+    /**
+     * @brief Reads the size and spatial information of a UBJSON grid,
+     *  the elevations are skipped.
+     */
+    GridInfo read_ubjson_grid_info(const std::filesystem::path& filename,
+                                   bool strict = false);
+
+    [[nodiscard]] bool is_ubjson_grid(const std::filesystem::path& filename);
+
+    [[nodiscard]] bool is_ubjson_grid(const void* buffer, size_t size);
+}
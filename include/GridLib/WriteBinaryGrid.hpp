@@ -0,0 +1,26 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+#include "IGrid.hpp"
+
+namespace GridLib
+{
+    /**
+     * @brief Writes @a grid in GridLib's binary format.
+     *
+     * The file has a small header with the grid's size and spatial
+     * information, followed by the elevations as an aligned, row-major
+     * array of float32 values that can be memory-mapped without parsing.
+     */
+    void write_binary_grid(std::ostream& stream, const IGrid& grid);
+
+    void write_binary_grid(const std::filesystem::path& filename,
+                           const IGrid& grid);
+}
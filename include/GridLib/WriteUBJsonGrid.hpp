@@ -0,0 +1,25 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+#include "IGrid.hpp"
+
+namespace GridLib
+{
+    /**
+     * @brief Writes @a grid as UBJSON with the same structure as
+     *  write_json.
+     *
+     * Each row of elevations is written as an optimized float32 array.
+     * Unknown elevations are stored as UNKNOWN_ELEVATION rather than null.
+     */
+    void write_ubjson(std::ostream& stream, const IGrid& grid);
+
+    void write_ubjson(const std::filesystem::path& filename, const IGrid& grid);
+}
@@ -9,14 +9,47 @@
 #include <filesystem>
 
 #include "GridLib/Grid.hpp"
+#include "GridLib/GridInfo.hpp"
 
 namespace GridLib
 {
     Grid read_dem(std::istream& stream);
 
-    Grid read_dem(const void* buffer, size_t size);
+    /**
+     * @brief Reads the DEM file in @a buffer.
+     *
+     * The profiles are decoded by up to @a thread_count threads, a
+     * @a thread_count of 0 uses the number of hardware threads. Pass 1
+     * when several files are decoded in parallel.
+     */
+    Grid read_dem(const void* buffer, size_t size, unsigned thread_count = 0);
 
-    Grid read_dem(const std::filesystem::path& filename);
+    /**
+     * @brief Reads the DEM file @a filename.
+     *
+     * See read_dem(const void*, size_t, unsigned) for @a thread_count.
+     */
+    Grid read_dem(const std::filesystem::path& filename, unsigned thread_count = 0);
+
+    /**
+     * @brief Reads the part of the DEM file that is inside @a window.
+     *
+     * @a window is in grid coordinates and is clamped to the grid.
+     * Profiles outside the window are skipped without being decoded.
+     * The spatial information is adjusted so that the returned grid's
+     * first elevation is at the window's origin.
+     */
+    Grid read_dem(const std::filesystem::path& filename, const Extent& window);
+
+    Grid read_dem(const void* buffer, size_t size, const Extent& window);
+
+    /**
+     * @brief Reads the size and spatial information of the DEM file
+     *  @a filename without decoding its elevations.
+     *
+     * Only record A and the header of the first profile are read.
+     */
+    [[nodiscard]] GridInfo read_dem_info(const std::filesystem::path& filename);
 
     [[nodiscard]] bool is_dem(const std::filesystem::path& filename);
 }
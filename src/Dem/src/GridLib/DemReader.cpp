@@ -51,7 +51,12 @@ namespace GridLib
 
     std::optional<RecordB> DemReader::next_record_b()
     {
-        return read_record_b();
+        return read_record_b(nullptr);
+    }
+
+    std::optional<RecordB> DemReader::next_record_b(ElevationSink& sink)
+    {
+        return read_record_b(&sink);
     }
 
     void DemReader::read_record_a()
@@ -72,25 +77,35 @@ namespace GridLib
         }
     }
 
-    std::optional<RecordB> DemReader::read_record_b()
+    bool DemReader::has_record_b()
     {
         if (!data_)
             GRIDLIB_THROW("No input stream.");
 
         if (!data_->reader.fill_buffer(1024))
-            return {};
+            return false;
 
         if (data_->a.data_validation_flag.value_or(0) != 0
-            && data_->reader.fill_buffer(2048)
+            && !data_->reader.fill_buffer(2048)
             && data_->reader.remaining_buffer_size() == 1024)
         {
             // We've reached the final 1024 bytes of the file, which contains
             // record type c.
-            return {};
+            return false;
         }
 
+        return true;
+    }
+
+    std::optional<RecordB> DemReader::read_record_b(ElevationSink* sink)
+    {
+        if (!has_record_b())
+            return {};
+
         try
         {
+            if (sink)
+                return GridLib::read_record_b(data_->reader, *sink);
             return GridLib::read_record_b(data_->reader);
         }
         catch (std::exception& ex)
@@ -35,11 +35,22 @@ namespace GridLib
 
         [[nodiscard]]
         std::optional<RecordB> next_record_b();
+
+        /**
+         * @brief Reads the next record B and passes its elevations to
+         *  @a sink.
+         *
+         * The returned record has no elevations.
+         */
+        std::optional<RecordB> next_record_b(ElevationSink& sink);
     private:
         void read_record_a();
 
         [[nodiscard]]
-        std::optional<RecordB> read_record_b();
+        bool has_record_b();
+
+        [[nodiscard]]
+        std::optional<RecordB> read_record_b(ElevationSink* sink);
 
         void read_record_c();
 
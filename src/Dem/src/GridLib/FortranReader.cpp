@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <istream>
 #include "GridLib/GridLibException.hpp"
+#include "ParseElevations.hpp"
 #include "ParseNumber.hpp"
 
 namespace GridLib
@@ -36,24 +37,33 @@ namespace GridLib
           stream_(&stream)
     {}
 
+    FortranReader::FortranReader(std::string_view data)
+        : data_(data),
+          str_(data)
+    {}
+
     std::optional<char> FortranReader::read_char()
     {
-        auto str = read_string(1);
+        auto str = read_view(1);
         if (str.empty())
             return {};
         return str[0];
     }
 
     std::string FortranReader::read_string(size_t size, bool trim_spaces)
+    {
+        return std::string(read_view(size, trim_spaces));
+    }
+
+    std::string_view FortranReader::read_view(size_t size, bool trim_spaces)
     {
         while (str_.size() < size && fill_buffer(size))
             continue;
         if (size > str_.size())
             GRIDLIB_THROW("End of file reached.");
-        size = std::min(size, str_.size());
         auto result = str_.substr(0, size);
         str_ = str_.substr(size);
-        return std::string(trim_spaces ? trim(result) : result);
+        return trim_spaces ? trim(result) : result;
     }
 
     std::optional<int8_t> FortranReader::read_int8(size_t size)
@@ -81,31 +91,55 @@ namespace GridLib
         return read_float<double>(size);
     }
 
+    void FortranReader::read_int32s(size_t field_size, size_t count,
+                                    std::vector<int32_t>& values)
+    {
+        const auto offset = values.size();
+        values.resize(offset + count);
+        read_int32s(field_size, std::span(values).subspan(offset));
+    }
+
+    void FortranReader::read_int32s(size_t field_size,
+                                    std::span<int32_t> values)
+    {
+        const auto count = values.size();
+        const auto str = read_view(field_size * count, false);
+        if (field_size == ELEVATION_FIELD_SIZE)
+        {
+            if (!parse_elevations(str, values))
+                GRIDLIB_THROW("Invalid integer");
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto field = trim(str.substr(i * field_size, field_size));
+            if (field.empty() || !parse(field, values[i]))
+                GRIDLIB_THROW("Invalid integer");
+        }
+    }
+
     bool FortranReader::fill_buffer(size_t size)
     {
-        if (!stream_ || !*stream_)
-            return false;
         if (str_.size() >= size)
             return true;
+        if (!stream_ || !*stream_)
+            return false;
+        const auto buffered = str_.size();
         if (str_.data() != buffer_.data())
         {
             std::copy(str_.begin(), str_.end(),
                       buffer_.begin());
-            str_ = {buffer_.data(), str_.size()};
         }
         if (buffer_.size() < size)
-        {
-            auto prevSize = buffer_.size();
             buffer_.resize(size);
-            str_ = {buffer_.data(), prevSize};
-        }
-        auto bytes_to_read = buffer_.size() - str_.size();
-        stream_->read(buffer_.data() + str_.size(),
+        auto bytes_to_read = buffer_.size() - buffered;
+        stream_->read(buffer_.data() + buffered,
                       std::streamsize(bytes_to_read));
         auto bytes_read = size_t(stream_->gcount());
-        buffer_.resize(str_.size() + bytes_read);
+        buffer_.resize(buffered + bytes_read);
         str_ = {buffer_.data(), buffer_.size()};
-        return bytes_read != 0;
+        return str_.size() >= size;
     }
 
     size_t FortranReader::remaining_buffer_size() const
@@ -121,6 +155,9 @@ namespace GridLib
             return;
         }
 
+        if (!stream_)
+            GRIDLIB_THROW("End of file reached.");
+
         size -= str_.size();
         str_ = {};
         auto start = std::streamoff(stream_->tellg());
@@ -141,19 +178,36 @@ namespace GridLib
             }
             pos -= std::streamoff(str_.size());
         }
+
+        if (!stream_)
+        {
+            const auto size = std::streamoff(data_.size());
+            if (dir == std::ios_base::cur)
+                pos += tell() + std::streamoff(str_.size());
+            else if (dir == std::ios_base::end)
+                pos += size;
+            if (pos < 0 || pos > size)
+                return false;
+            str_ = data_.substr(size_t(pos));
+            return true;
+        }
+
         str_ = {};
-        return bool(stream_->seekg(pos));
+        stream_->clear();
+        return bool(stream_->seekg(pos, dir));
     }
 
     std::streamsize FortranReader::tell() const
     {
+        if (!stream_)
+            return std::streamsize(data_.size() - str_.size());
         return std::streamsize(stream_->tellg()) - std::streamsize(str_.size());
     }
 
     template <typename T>
     std::optional<T> FortranReader::read_int(size_t size)
     {
-        auto str = read_string(size);
+        auto str = read_view(size);
         if (str.empty())
             return {};
         T n;
@@ -165,7 +219,7 @@ namespace GridLib
     template <typename T>
     std::optional<T> FortranReader::read_float(size_t size)
     {
-        auto str = read_string(size);
+        auto str = read_view(size);
         if (str.empty())
             return {};
         T n;
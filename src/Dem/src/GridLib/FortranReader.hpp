@@ -8,6 +8,7 @@
 #pragma once
 #include <iosfwd>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -23,8 +24,22 @@ namespace GridLib
         explicit FortranReader(std::istream& stream,
                                size_t buffer_size = 8192);
 
+        /**
+         * @brief Reads directly from @a data, which must remain valid
+         *  for as long as the reader is used.
+         */
+        explicit FortranReader(std::string_view data);
+
         std::string read_string(size_t size, bool trim_spaces = true);
 
+        /**
+         * @brief Returns a view of the next @a size characters.
+         *
+         * The view points into the reader's buffer and is only valid
+         * until the next call to any of the reader's member functions.
+         */
+        std::string_view read_view(size_t size, bool trim_spaces = true);
+
         std::optional<char> read_char();
 
         std::optional<int8_t> read_int8(size_t size);
@@ -37,6 +52,22 @@ namespace GridLib
 
         std::optional<double> read_float64(size_t size);
 
+        /**
+         * @brief Reads @a count integers that each occupy @a field_size
+         *  characters and appends them to @a values.
+         *
+         * The fields are parsed in place in the reader's buffer. Empty
+         * fields are an error.
+         */
+        void read_int32s(size_t field_size, size_t count,
+                         std::vector<int32_t>& values);
+
+        /**
+         * @brief Reads one integer per element in @a values, each
+         *  occupying @a field_size characters.
+         */
+        void read_int32s(size_t field_size, std::span<int32_t> values);
+
         void skip(size_t size);
 
         [[nodiscard]]
@@ -56,6 +87,8 @@ namespace GridLib
         std::optional<T> read_float(size_t size);
 
         std::istream* stream_ = nullptr;
+        // The entire input when the reader reads from memory.
+        std::string_view data_;
         std::string_view str_;
         std::vector<char> buffer_;
     };
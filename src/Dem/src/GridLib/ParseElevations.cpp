@@ -0,0 +1,208 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParseElevations.hpp"
+
+#include <algorithm>
+#include "ParseNumber.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define GRIDLIB_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define GRIDLIB_TARGET_SSSE3
+    #else
+        #define GRIDLIB_TARGET_SSSE3 __attribute__((target("ssse3")))
+    #endif
+#endif
+
+namespace GridLib
+{
+    namespace
+    {
+        std::string_view trim(std::string_view str)
+        {
+            const auto first = str.find_first_not_of(' ');
+            if (first == std::string_view::npos)
+                return {};
+            const auto last = str.find_last_not_of(' ');
+            return str.substr(first, last + 1 - first);
+        }
+
+        bool parse_field(std::string_view str, int32_t& value)
+        {
+            const auto field = trim(str);
+            return !field.empty() && parse(field, value);
+        }
+
+#ifdef GRIDLIB_X86
+        bool has_ssse3()
+        {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 9)) != 0;
+#else
+            return __builtin_cpu_supports("ssse3");
+#endif
+        }
+
+        /**
+         * Checks the character classes of a field that has been moved
+         * to the upper six bytes of an eight byte lane. Each mask has
+         * one bit per byte in the lane.
+         *
+         * A valid field has zero or more spaces, an optional minus and
+         * one or more digits, in that order.
+         */
+        bool is_valid_field(unsigned digits, unsigned spaces, unsigned minus)
+        {
+            constexpr unsigned FIELD_BITS = 0xFCu;
+            digits &= FIELD_BITS;
+            const auto lowest_digit = digits & (0u - digits);
+            return digits != 0
+                   && digits + lowest_digit == 0x100u
+                   && (minus == 0 || minus == lowest_digit >> 1)
+                   && spaces == (FIELD_BITS & ~digits & ~minus);
+        }
+
+        /**
+         * Parses four fields. Returns false, without parsing any of them,
+         * if any of the fields aren't on the form the vectorized code
+         * handles.
+         */
+        GRIDLIB_TARGET_SSSE3
+        bool parse_4_fields_ssse3(const char* str, int32_t* values)
+        {
+            // Moves two six-byte fields into the upper bytes of two
+            // eight-byte lanes, the two lower bytes in each lane are
+            // zeroed.
+            const auto shuffle = _mm_setr_epi8(-1, -1, 0, 1, 2, 3, 4, 5,
+                                               -1, -1, 6, 7, 8, 9, 10, 11);
+            // Turns the zeroed bytes into '0' digits.
+            const auto padding = _mm_setr_epi8('0', '0', 0, 0, 0, 0, 0, 0,
+                                               '0', '0', 0, 0, 0, 0, 0, 0);
+            const auto zero_char = _mm_set1_epi8('0');
+            const auto nine = _mm_set1_epi8(9);
+            const auto space_char = _mm_set1_epi8(' ');
+            const auto minus_char = _mm_set1_epi8('-');
+            const auto weights_1 = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1,
+                                                 10, 1, 10, 1, 10, 1, 10, 1);
+            const auto weights_2 = _mm_setr_epi16(100, 1, 100, 1,
+                                                  100, 1, 100, 1);
+            const auto weights_3 = _mm_setr_epi16(10000, 1, 10000, 1,
+                                                  10000, 1, 10000, 1);
+
+            __m128i pairs[2];
+            unsigned negative = 0;
+            for (int i = 0; i < 2; ++i)
+            {
+                const auto input = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(str + 12 * i));
+                const auto chars = _mm_or_si128(_mm_shuffle_epi8(input, shuffle),
+                                                padding);
+                const auto digits = _mm_sub_epi8(chars, zero_char);
+                const auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, nine),
+                                                     digits);
+                const auto digit_bits = unsigned(_mm_movemask_epi8(is_digit));
+                const auto space_bits = unsigned(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(chars, space_char)));
+                const auto minus_bits = unsigned(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(chars, minus_char)));
+                for (int j = 0; j < 2; ++j)
+                {
+                    const auto shift = 8 * j;
+                    const auto minus = (minus_bits >> shift) & 0xFFu;
+                    if (!is_valid_field((digit_bits >> shift) & 0xFFu,
+                                        (space_bits >> shift) & 0xFFu,
+                                        minus))
+                    {
+                        return false;
+                    }
+                    if (minus)
+                        negative |= 1u << (2 * i + j);
+                }
+
+                // Spaces and minus signs are zeroed, the digits are
+                // combined pairwise to values from 0 to 99 and then to
+                // values from 0 to 9999.
+                const auto values_1 = _mm_maddubs_epi16(
+                    _mm_and_si128(digits, is_digit), weights_1);
+                pairs[i] = _mm_madd_epi16(values_1, weights_2);
+            }
+
+            // Each lane now holds its upper and lower four digits in two
+            // 32-bit integers, combine them to the final values.
+            const auto packed = _mm_packs_epi32(pairs[0], pairs[1]);
+            const auto result = _mm_madd_epi16(packed, weights_3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values), result);
+            for (int i = 0; i < 4; ++i)
+            {
+                if (negative & (1u << i))
+                    values[i] = -values[i];
+            }
+            return true;
+        }
+
+        bool parse_elevations_ssse3(std::string_view str,
+                                    std::span<int32_t> values)
+        {
+            constexpr size_t GROUP_SIZE = 4 * ELEVATION_FIELD_SIZE;
+            // The second load in parse_4_fields_ssse3 reads 16 bytes
+            // starting 12 bytes into the group.
+            constexpr size_t LOAD_SIZE = 12 + 16;
+
+            size_t i = 0;
+            for (; i + 4 <= values.size()
+                   && i * ELEVATION_FIELD_SIZE + LOAD_SIZE <= str.size(); i += 4)
+            {
+                const auto* group = str.data() + i * ELEVATION_FIELD_SIZE;
+                if (!parse_4_fields_ssse3(group, &values[i])
+                    && !parse_elevations_scalar({group, GROUP_SIZE},
+                                                values.subspan(i, 4)))
+                {
+                    return false;
+                }
+            }
+
+            return parse_elevations_scalar(str.substr(i * ELEVATION_FIELD_SIZE),
+                                           values.subspan(i));
+        }
+#endif
+
+        using ParseFunc = bool (*)(std::string_view, std::span<int32_t>);
+
+        ParseFunc select_parse_function()
+        {
+#ifdef GRIDLIB_X86
+            if (has_ssse3())
+                return parse_elevations_ssse3;
+#endif
+            return parse_elevations_scalar;
+        }
+    }
+
+    bool parse_elevations(std::string_view str, std::span<int32_t> values)
+    {
+        static const auto parse_func = select_parse_function();
+        return parse_func(str, values);
+    }
+
+    bool parse_elevations_scalar(std::string_view str,
+                                 std::span<int32_t> values)
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const auto field = str.substr(i * ELEVATION_FIELD_SIZE,
+                                          ELEVATION_FIELD_SIZE);
+            if (!parse_field(field, values[i]))
+                return false;
+        }
+        return true;
+    }
+}
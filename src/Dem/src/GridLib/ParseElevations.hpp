@@ -0,0 +1,35 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace GridLib
+{
+    constexpr size_t ELEVATION_FIELD_SIZE = 6;
+
+    /**
+     * @brief Parses the 6-character integer fields in @a str into
+     *  @a values.
+     *
+     * @a str must contain exactly ELEVATION_FIELD_SIZE characters per
+     * value. Fields are parsed as by parse() after leading and trailing
+     * spaces have been removed. Returns false if any of the fields isn't
+     * a valid integer.
+     *
+     * Uses SSSE3 instructions when the CPU supports them.
+     */
+    bool parse_elevations(std::string_view str, std::span<int32_t> values);
+
+    /**
+     * @brief The portable implementation of parse_elevations.
+     */
+    bool parse_elevations_scalar(std::string_view str,
+                                 std::span<int32_t> values);
+}
@@ -7,11 +7,18 @@
 //****************************************************************************
 #include "GridLib/ReadDem.hpp"
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <span>
+#include <thread>
 #include "DemReader.hpp"
+#include "FortranReader.hpp"
+#include "ParseElevations.hpp"
 #include "GridLib/GridLibException.hpp"
-#include "GridLib/Utilities/ReadOnlyStreamBuffer.hpp"
+#include "GridLib/Utilities/MemoryMappedFile.hpp"
 
 namespace GridLib
 {
@@ -71,123 +78,481 @@ namespace GridLib
         GRIDLIB_THROW("Unsupported reference system: " + std::to_string(ref_sys));
     }
 
-    Grid read_dem(std::istream& stream)
+    namespace
     {
-        Grid grid;
-        DemReader reader(stream);
-        auto& a = reader.record_a();
+        constexpr size_t DEM_BLOCK_SIZE = 1024;
+        constexpr size_t PROFILE_HEADER_SIZE = 4 * 6 + 5 * 24;
+        constexpr size_t MIN_PROFILES_PER_TASK = 16;
+        constexpr size_t FIELDS_PER_BLOCK = DEM_BLOCK_SIZE / ELEVATION_FIELD_SIZE;
+        constexpr size_t FIELDS_IN_FIRST_BLOCK =
+            (DEM_BLOCK_SIZE - PROFILE_HEADER_SIZE) / ELEVATION_FIELD_SIZE;
 
-        auto rows = a.rows.value_or(1);
-        auto cols = a.columns.value_or(1);
+        SpatialInfo make_spatial_info(const RecordA& a)
+        {
+            SpatialInfo model;
+            auto rows = a.rows.value_or(1);
+            auto cols = a.columns.value_or(1);
 
-        auto crs = get_crs(a);
-        auto z = a.vertical_datum_shift.value_or(0);
+            auto crs = get_crs(a);
+            auto z = a.vertical_datum_shift.value_or(0);
 
-        auto& model = grid.spatial_info();
+            std::vector<SpatialTiePoint> spatial_ties;
+            if (a.longitude && a.latitude)
+            {
+                spatial_ties.push_back({
+                    {0, 0},
+                    {to_degrees(*a.latitude), to_degrees(*a.longitude), z},
+                    {4326, 0, CrsType::GEOGRAPHIC, CrsLibrary::EPSG}
+                });
+            }
+            if (const auto& c = a.quadrangle_corners[0])
+            {
+                model.set_location({c->easting, c->northing, z});
+                spatial_ties.push_back({
+                    {0, 0},
+                    {c->easting, c->northing, z},
+                    crs
+                });
+            }
+            if (const auto& c = a.quadrangle_corners[1])
+            {
+                spatial_ties.push_back({
+                    {double(rows - 1), 0},
+                    {c->easting, c->northing, z},
+                    crs
+                });
+            }
+            if (const auto& c = a.quadrangle_corners[2])
+            {
+                spatial_ties.push_back({
+                    {double(rows - 1), double(cols - 1)},
+                    {c->easting, c->northing, z},
+                    crs
+                });
+            }
+            if (const auto& c = a.quadrangle_corners[3])
+            {
+                spatial_ties.push_back({
+                    {0, double(cols - 1)},
+                    {c->easting, c->northing, z},
+                    crs
+                });
+            }
 
-        std::vector<SpatialTiePoint> spatial_ties;
-        if (a.longitude && a.latitude)
+            model.extra_tie_points = std::move(spatial_ties);
+
+            auto h_unit = from_dem_unit(a.horizontal_unit.value_or(0));
+            double c_res = a.x_resolution.value_or(1.0);
+            double r_res = a.y_resolution.value_or(1.0);
+
+            auto v_unit = from_dem_unit(a.vertical_unit.value_or(0));
+            float v_res = to_float(a.z_resolution.value_or(1.0));
+
+            auto rot = a.rotation_angle.value_or(0);
+            auto row_axis = rotate(Xyz::Vector2D(0.0, r_res), rot);
+            model.set_row_axis(Xyz::make_vector3(row_axis, 0.0));
+            auto col_axis = rotate(Xyz::Vector2D(c_res, 0.0), rot);
+            model.set_column_axis(Xyz::make_vector3(col_axis, 0.0));
+            model.set_vertical_axis({0, 0, v_res});
+            model.crs = crs;
+
+            model.horizontal_unit = h_unit;
+            model.vertical_unit = v_unit;
+            return model;
+        }
+
+        /**
+         * Creates an empty grid with the spatial information in @a a.
+         */
+        Grid make_grid(const RecordA& a)
         {
-            spatial_ties.push_back({
-                {0, 0},
-                {to_degrees(*a.latitude), to_degrees(*a.longitude), z},
-                {4326, 0, CrsType::GEOGRAPHIC, CrsLibrary::EPSG}
-            });
+            Grid grid;
+            grid.spatial_info() = make_spatial_info(a);
+            return grid;
         }
-        if (const auto& c = a.quadrangle_corners[0])
+
+        /**
+         * DEM files use columns as the primary dimension, while Grid uses
+         * rows. The grid has one row per profile.
+         */
+        Size get_grid_size(const RecordA& a, int first_profile_rows)
         {
-            model.set_location({c->easting, c->northing, z});
-            spatial_ties.push_back({
-                {0, 0},
-                {c->easting, c->northing, z},
-                crs
-            });
+            auto rows = a.rows.value_or(1);
+            if (rows == 1)
+                rows = int16_t(first_profile_rows);
+            return {size_t(a.columns.value_or(1)), size_t(rows)};
         }
-        if (const auto& c = a.quadrangle_corners[1])
+
+        /**
+         * Scales the elevations of each profile and writes them
+         * directly to the profile's row in the grid.
+         */
+        class GridElevationSink : public ElevationSink
+        {
+        public:
+            /**
+             * The grid is resized when the first profile arrives, as
+             * its size can depend on the profile's header.
+             */
+            GridElevationSink(Grid& grid, const RecordA& a)
+                : grid_(&grid),
+                  a_(&a),
+                  v_res_(to_float(a.z_resolution.value_or(1.0)))
+            {}
+
+            GridElevationSink(Chorasmia::MutableArrayView2D<float> values,
+                              float v_res)
+                : values_(values),
+                  v_res_(v_res)
+            {}
+
+            void begin_profile(const RecordB& b) override
+            {
+                if (grid_ && values_.empty())
+                {
+                    grid_->resize(get_grid_size(*a_, b.rows));
+                    values_ = grid_->values();
+                }
+
+                const auto [grid_rows, grid_cols] = values_.dimensions();
+                if (b.column < 1 || b.row < 1 || b.columns < 0 || b.rows < 0
+                    || size_t(b.column - 1 + b.columns) > grid_rows
+                    || size_t(b.row - 1 + b.rows) > grid_cols)
+                {
+                    GRIDLIB_THROW("Profile " + std::to_string(b.column)
+                                  + " is outside the grid.");
+                }
+
+                first_row_ = size_t(b.column - 1);
+                first_col_ = size_t(b.row - 1);
+                profile_rows_ = size_t(b.rows);
+            }
+
+            void add_elevations(size_t offset,
+                                std::span<const int32_t> values) override
+            {
+                auto i = offset / profile_rows_;
+                auto j = offset % profile_rows_;
+                while (!values.empty())
+                {
+                    const auto n = std::min(values.size(), profile_rows_ - j);
+                    auto dst = values_.row(first_row_ + i).begin() + (first_col_ + j);
+                    for (const auto elev : values.first(n))
+                    {
+                        *dst++ = elev == UNKNOWN
+                                     ? UNKNOWN_ELEVATION
+                                     : float(elev) * v_res_;
+                    }
+                    values = values.subspan(n);
+                    j = 0;
+                    ++i;
+                }
+            }
+        private:
+            Grid* grid_ = nullptr;
+            const RecordA* a_ = nullptr;
+            Chorasmia::MutableArrayView2D<float> values_;
+            float v_res_ = 1;
+            size_t first_row_ = 0;
+            size_t first_col_ = 0;
+            size_t profile_rows_ = 0;
+        };
+
+        void read_profile(FortranReader& reader, ElevationSink& sink)
         {
-            spatial_ties.push_back({
-                {double(rows - 1), 0},
-                {c->easting, c->northing, z},
-                crs
-            });
+            try
+            {
+                read_record_b(reader, sink);
+            }
+            catch (std::exception& ex)
+            {
+                GRIDLIB_THROW("Invalid record of type B.\n    "
+                              + std::string(ex.what()));
+            }
         }
-        if (const auto& c = a.quadrangle_corners[2])
+
+        struct ProfileHeader
         {
-            spatial_ties.push_back({
-                {double(rows - 1), double(cols - 1)},
-                {c->easting, c->northing, z},
-                crs
-            });
+            int32_t row = 0;
+            int32_t column = 0;
+            int32_t rows = 0;
+            int32_t columns = 0;
+        };
+
+        ProfileHeader read_profile_header(std::string_view data)
+        {
+            FortranReader reader(data);
+            const auto row = reader.read_int32(6);
+            const auto column = reader.read_int32(6);
+            const auto rows = reader.read_int32(6);
+            const auto columns = reader.read_int32(6);
+            if (!row || !column || !rows || !columns
+                || *row < 1 || *column < 1 || *rows < 0 || *columns < 0)
+            {
+                GRIDLIB_THROW("Invalid record of type B.");
+            }
+            return {*row, *column, *rows, *columns};
         }
-        if (const auto& c = a.quadrangle_corners[3])
+
+        /**
+         * Returns the position of elevation number @a index in its
+         * profile, and the number of elevations from there to the end of
+         * its block.
+         */
+        std::pair<size_t, size_t> get_elevation_position(size_t index)
         {
-            spatial_ties.push_back({
-                {0, double(cols - 1)},
-                {c->easting, c->northing, z},
-                crs
-            });
+            if (index < FIELDS_IN_FIRST_BLOCK)
+            {
+                return {PROFILE_HEADER_SIZE + index * ELEVATION_FIELD_SIZE,
+                        FIELDS_IN_FIRST_BLOCK - index};
+            }
+
+            index -= FIELDS_IN_FIRST_BLOCK;
+            const auto block = 1 + index / FIELDS_PER_BLOCK;
+            const auto field = index % FIELDS_PER_BLOCK;
+            return {block * DEM_BLOCK_SIZE + field * ELEVATION_FIELD_SIZE,
+                    FIELDS_PER_BLOCK - field};
         }
 
-        model.extra_tie_points = std::move(spatial_ties);
+        /**
+         * Decodes and scales the elevations in @a profile starting with
+         * elevation number @a first into @a values.
+         */
+        void decode_elevations(std::string_view profile, size_t first,
+                               float v_res, std::span<float> values)
+        {
+            std::array<int32_t, FIELDS_PER_BLOCK> buffer;
+            while (!values.empty())
+            {
+                const auto [pos, available] = get_elevation_position(first);
+                const auto n = std::min(values.size(), available);
+                const auto size = n * ELEVATION_FIELD_SIZE;
+                if (pos + size > profile.size()
+                    || !parse_elevations(profile.substr(pos, size),
+                                         std::span(buffer).first(n)))
+                {
+                    GRIDLIB_THROW("Invalid record of type B.");
+                }
+
+                for (size_t i = 0; i < n; ++i)
+                {
+                    values[i] = buffer[i] == UNKNOWN
+                                    ? UNKNOWN_ELEVATION
+                                    : float(buffer[i]) * v_res;
+                }
+                values = values.subspan(n);
+                first += n;
+            }
+        }
 
-        auto h_unit = from_dem_unit(a.horizontal_unit.value_or(0));
-        double c_res = a.x_resolution.value_or(1.0);
-        double r_res = a.y_resolution.value_or(1.0);
+        /**
+         * Returns the data of each profile (record B) in @a data, the
+         * first profile starts at @a offset.
+         *
+         * The profiles' sizes are computed from the number of
+         * elevations in their headers, the elevations themselves are
+         * not parsed.
+         */
+        std::vector<std::string_view>
+        find_profiles(std::string_view data, size_t offset, const RecordA& a)
+        {
+            auto end = data.size();
+            // The final 1024 bytes contain record C.
+            if (a.data_validation_flag.value_or(0) != 0 && end >= offset + DEM_BLOCK_SIZE)
+                end -= DEM_BLOCK_SIZE;
 
-        auto v_unit = from_dem_unit(a.vertical_unit.value_or(0));
-        float v_res = to_float(a.z_resolution.value_or(1.0));
+            std::vector<std::string_view> profiles;
+            while (offset < end)
+            {
+                const auto [row, column, rows, columns] = read_profile_header(
+                    data.substr(offset, PROFILE_HEADER_SIZE));
+                const auto count = size_t(rows) * size_t(columns);
+                size_t blocks = 1;
+                if (count > FIELDS_IN_FIRST_BLOCK)
+                    blocks += (count - FIELDS_IN_FIRST_BLOCK + FIELDS_PER_BLOCK - 1) / FIELDS_PER_BLOCK;
+                const auto size = std::min(blocks * DEM_BLOCK_SIZE, end - offset);
+                profiles.push_back(data.substr(offset, size));
+                offset += size;
+            }
+            return profiles;
+        }
 
-        auto rot = a.rotation_angle.value_or(0);
-        auto row_axis = rotate(Xyz::Vector2D(0.0, r_res), rot);
-        model.set_row_axis(Xyz::make_vector3(row_axis, 0.0));
-        auto col_axis = rotate(Xyz::Vector2D(c_res, 0.0), rot);
-        model.set_column_axis(Xyz::make_vector3(col_axis, 0.0));
-        model.set_vertical_axis({0, 0, v_res});
-        model.crs = crs;
+        void decode_profiles(std::span<const std::string_view> profiles,
+                             float v_res,
+                             Chorasmia::MutableArrayView2D<float> values)
+        {
+            GridElevationSink sink(values, v_res);
+            for (const auto& profile : profiles)
+            {
+                FortranReader reader(profile);
+                read_profile(reader, sink);
+            }
+        }
 
-        model.horizontal_unit = h_unit;
-        model.vertical_unit = v_unit;
+        RecordA read_record_a(std::string_view data)
+        {
+            try
+            {
+                FortranReader reader(data);
+                return GridLib::read_record_a(reader);
+            }
+            catch (std::exception& ex)
+            {
+                GRIDLIB_THROW("The stream doesn't contain"
+                              " a valid record of type A.\n    "
+                              + std::string(ex.what()));
+            }
+        }
 
-        Chorasmia::MutableArrayView2D<float> values;
-        while (auto b = reader.next_record_b())
+        Grid read_dem(std::string_view data, unsigned thread_count)
         {
-            if (values.empty())
+            const auto a = read_record_a(data);
+            auto grid = make_grid(a);
+            const auto profiles = find_profiles(data, DEM_BLOCK_SIZE, a);
+            if (profiles.empty())
+                return grid;
+
+            grid.resize(get_grid_size(a, read_profile_header(profiles[0]).rows));
+            const auto values = grid.values();
+            const float v_res = to_float(a.z_resolution.value_or(1.0));
+
+            // Each profile is written to its own row in the grid, so the
+            // profiles can be decoded independently.
+            if (thread_count == 0)
+                thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+            const auto task_count = std::clamp<size_t>(
+                profiles.size() / MIN_PROFILES_PER_TASK, 1, thread_count);
+            std::vector<std::future<void>> tasks;
+            const auto profiles_per_task = (profiles.size() + task_count - 1) / task_count;
+            for (size_t i = profiles_per_task; i < profiles.size(); i += profiles_per_task)
             {
-                if (rows == 1)
-                    rows = b->rows;
-                // DEM files uses columns as the primary dimension, while Grid
-                // uses rows.
-                grid.resize({size_t(cols), size_t(rows)});
-                values = grid.values();
+                const auto task_profiles = std::span(profiles).subspan(
+                    i, std::min(profiles_per_task, profiles.size() - i));
+                tasks.push_back(std::async(std::launch::async, decode_profiles,
+                                           task_profiles, v_res, values));
             }
-            for (int i = 0; i < b->columns; ++i)
+
+            decode_profiles(std::span(profiles).first(std::min(profiles_per_task,
+                                                               profiles.size())),
+                            v_res, values);
+            for (auto& task : tasks)
+                task.get();
+
+            return grid;
+        }
+
+        Grid read_dem(std::string_view data, const Extent& window)
+        {
+            const auto a = read_record_a(data);
+            const auto profiles = find_profiles(data, DEM_BLOCK_SIZE, a);
+            Size grid_size;
+            if (!profiles.empty())
+                grid_size = get_grid_size(a, read_profile_header(profiles[0]).rows);
+            const auto extent = clamp(window, grid_size);
+            const auto [row0, col0] = extent.origin;
+            const auto [n_rows, n_cols] = extent.size;
+
+            Grid grid;
+            auto& model = grid.spatial_info();
+            model = make_spatial_info(a);
+            model.set_location(model.location()
+                               + double(row0) * model.column_axis()
+                               + double(col0) * model.row_axis());
+            const Xyz::Vector2D offset(static_cast<double>(row0),
+                                       static_cast<double>(col0));
+            for (auto& tie_point : model.extra_tie_points)
+                tie_point.grid_point = tie_point.grid_point - offset;
+
+            grid.resize(extent.size);
+            const auto values = grid.values();
+            const float v_res = to_float(a.z_resolution.value_or(1.0));
+
+            for (const auto& profile : profiles)
             {
-                for (int j = 0; j < b->rows; ++j)
+                // Each column in a profile is a row in the grid.
+                const auto h = read_profile_header(profile);
+                const auto first_row = size_t(h.column - 1);
+                const auto first_col = size_t(h.row - 1);
+                const auto row_begin = std::max(first_row, row0);
+                const auto row_end = std::min(first_row + size_t(h.columns),
+                                              row0 + n_rows);
+                const auto col_begin = std::max(first_col, col0);
+                const auto col_end = std::min(first_col + size_t(h.rows),
+                                              col0 + n_cols);
+                if (row_begin >= row_end || col_begin >= col_end)
+                    continue;
+
+                for (auto r = row_begin; r < row_end; ++r)
                 {
-                    auto elev = b->elevations[i * b->rows + j];
-                    float value = elev == UNKNOWN
-                                      ? UNKNOWN_ELEVATION
-                                      : float(elev) * v_res;
-                    Index index(i + b->column - 1, j + b->row - 1);
-                    values[index] = value;
+                    const auto first = (r - first_row) * size_t(h.rows)
+                                       + (col_begin - first_col);
+                    auto dst = values.row(r - row0).begin() + (col_begin - col0);
+                    decode_elevations(profile, first, v_res,
+                                      std::span(dst, col_end - col_begin));
                 }
             }
+
+            return grid;
+        }
+    }
+
+    Grid read_dem(std::istream& stream)
+    {
+        DemReader reader(stream);
+        auto& a = reader.record_a();
+        auto grid = make_grid(a);
+        GridElevationSink sink(grid, a);
+        while (reader.next_record_b(sink))
+        {
         }
 
         return grid;
     }
 
-    Grid read_dem(const void* buffer, size_t size)
+    Grid read_dem(const void* buffer, size_t size, const Extent& window)
     {
-        ReadOnlyStreamBuffer stream_buffer(static_cast<const char*>(buffer), size);
-        std::istream stream(&stream_buffer);
-        return read_dem(stream);
+        return read_dem(std::string_view(static_cast<const char*>(buffer), size),
+                        window);
     }
 
-    Grid read_dem(const std::filesystem::path& filename)
+    Grid read_dem(const void* buffer, size_t size, unsigned thread_count)
+    {
+        return read_dem(std::string_view(static_cast<const char*>(buffer), size),
+                        thread_count);
+    }
+
+    Grid read_dem(const std::filesystem::path& filename, unsigned thread_count)
+    {
+        const MemoryMappedFile file(filename);
+        return read_dem(file.view(), thread_count);
+    }
+
+    Grid read_dem(const std::filesystem::path& filename, const Extent& window)
+    {
+        const MemoryMappedFile file(filename);
+        return read_dem(file.view(), window);
+    }
+
+    GridInfo read_dem_info(const std::filesystem::path& filename)
     {
         std::ifstream file(filename, std::ios::binary);
-        return read_dem(file);
+        if (!file)
+            GRIDLIB_THROW("Unable to open file: " + filename.string());
+
+        // Record A and the header of the first record B.
+        std::string data(DEM_BLOCK_SIZE + PROFILE_HEADER_SIZE, ' ');
+        file.read(data.data(), std::streamsize(data.size()));
+        data.resize(size_t(file.gcount()));
+
+        const auto a = read_record_a(data);
+        GridInfo result{{}, make_spatial_info(a)};
+        if (data.size() == DEM_BLOCK_SIZE + PROFILE_HEADER_SIZE)
+        {
+            const auto header = read_profile_header(
+                std::string_view(data).substr(DEM_BLOCK_SIZE));
+            result.size = get_grid_size(a, header.rows);
+        }
+        return result;
     }
 
     bool is_dem(const std::filesystem::path& filename)
@@ -7,12 +7,49 @@
 //****************************************************************************
 #include "RecordB.hpp"
 
+#include <array>
 #include "FortranReader.hpp"
 
 namespace GridLib
 {
     constexpr size_t BLOCK_SIZE = 1024;
+    constexpr size_t FIELD_SIZE = 6;
+
+    namespace
+    {
+        class VectorSink : public ElevationSink
+        {
+        public:
+            explicit VectorSink(std::vector<int32_t>& elevations)
+                : elevations_(elevations)
+            {}
+
+            void begin_profile(const RecordB& header) override
+            {
+                elevations_.reserve(size_t(header.rows) * header.columns);
+            }
+
+            void add_elevations(size_t,
+                                std::span<const int32_t> values) override
+            {
+                elevations_.insert(elevations_.end(),
+                                   values.begin(), values.end());
+            }
+        private:
+            std::vector<int32_t>& elevations_;
+        };
+    }
+
     RecordB read_record_b(FortranReader& reader)
+    {
+        std::vector<int32_t> elevations;
+        VectorSink sink(elevations);
+        auto result = read_record_b(reader, sink);
+        result.elevations = std::move(elevations);
+        return result;
+    }
+
+    RecordB read_record_b(FortranReader& reader, ElevationSink& sink)
     {
         RecordB result;
         result.row = *reader.read_int16(6);
@@ -24,17 +61,22 @@ namespace GridLib
         result.elevation_base = *reader.read_float64(24);
         result.elevation_min = reader.read_float64(24);
         result.elevation_max = reader.read_float64(24);
+        sink.begin_profile(result);
 
+        // Each block is decoded into this buffer and passed on to the sink.
+        std::array<int32_t, BLOCK_SIZE / FIELD_SIZE> buffer;
         size_t blockPos = 4 * 6 + 5 * 24;
+        size_t offset = 0;
         size_t remainder = result.rows * result.columns;
-        result.elevations.reserve(remainder);
         while (remainder > 0)
         {
-            auto n = std::min((BLOCK_SIZE - blockPos) / 6, remainder);
-            for (size_t i = 0; i < n; ++i)
-                result.elevations.push_back(*reader.read_int16(6));
+            auto n = std::min((BLOCK_SIZE - blockPos) / FIELD_SIZE, remainder);
+            const auto values = std::span(buffer).first(n);
+            reader.read_int32s(FIELD_SIZE, values);
+            sink.add_elevations(offset, values);
+            offset += n;
             remainder -= n;
-            blockPos += n * 6;
+            blockPos += n * FIELD_SIZE;
             reader.skip(BLOCK_SIZE - blockPos);
             blockPos = 0;
         }
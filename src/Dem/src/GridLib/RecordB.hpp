@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace GridLib
@@ -27,8 +28,38 @@ namespace GridLib
         std::vector<int32_t> elevations;
     };
 
+    /**
+     * @brief Receives the elevations of a record B as they are decoded.
+     */
+    class ElevationSink
+    {
+    public:
+        virtual ~ElevationSink() = default;
+
+        /**
+         * @brief Called with the profile's header, i.e. a RecordB without
+         *  elevations, before any of its elevations.
+         */
+        virtual void begin_profile(const RecordB& header) = 0;
+
+        /**
+         * @brief Called with the next consecutive run of the profile's
+         *  raw elevations, @a offset is the index of the first of them.
+         *
+         * @a values is only valid for the duration of the call.
+         */
+        virtual void add_elevations(size_t offset,
+                                    std::span<const int32_t> values) = 0;
+    };
+
     class FortranReader;
 
     [[nodiscard]]
     RecordB read_record_b(FortranReader& reader);
+
+    /**
+     * @brief Reads a record B and passes its elevations to @a sink
+     *  instead of storing them in the returned record.
+     */
+    RecordB read_record_b(FortranReader& reader, ElevationSink& sink);
 }
@@ -8,6 +8,7 @@
 #pragma once
 #include <filesystem>
 #include "GridLib/Grid.hpp"
+#include "GridLib/GridInfo.hpp"
 
 namespace GridLib
 {
@@ -17,6 +18,28 @@ namespace GridLib
 
     [[nodiscard]] Grid read_geotiff(const std::filesystem::path& path);
 
+    /**
+     * @brief Reads the part of the GeoTIFF file that is inside @a window.
+     *
+     * @a window is in grid coordinates and is clamped to the grid. Only
+     * the strips or tiles that intersect the window are decompressed,
+     * except in files with other compressions than LZW, Deflate and
+     * PackBits, which are decoded in their entirety. The spatial
+     * information is adjusted so that the returned grid's first
+     * elevation is at the window's origin.
+     */
+    [[nodiscard]] Grid read_geotiff(const std::filesystem::path& path,
+                                    const Extent& window);
+
+    [[nodiscard]] Grid read_geotiff(const void* buffer, size_t size,
+                                    const Extent& window);
+
+    /**
+     * @brief Reads the size and spatial information of a GeoTIFF file
+     *  from its header, the raster is not decoded.
+     */
+    [[nodiscard]] GridInfo read_geotiff_info(const std::filesystem::path& path);
+
     [[nodiscard]] bool is_tiff(const std::filesystem::path& path);
 
     [[nodiscard]]bool is_tiff(const void* buffer, size_t size);
@@ -0,0 +1,62 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include "GridLib/IGrid.hpp"
+
+namespace GridLib
+{
+    enum class GeoTiffCompression
+    {
+        NONE,
+        DEFLATE
+    };
+
+    struct GeoTiffWriteOptions
+    {
+        /**
+         * @brief The width and height of the tiles.
+         *
+         * Must be a multiple of 16. 0 writes strips instead of tiles.
+         */
+        size_t tile_size = 256;
+
+        GeoTiffCompression compression = GeoTiffCompression::DEFLATE;
+
+        /**
+         * @brief The zlib compression level, from 1 (fastest) to 9 (best).
+         */
+        int compression_level = 6;
+
+        /**
+         * @brief Apply TIFF's floating point predictor to the elevations
+         *  before they are compressed.
+         */
+        bool predictor = true;
+
+        /**
+         * @brief The number of threads that compress tiles or strips.
+         *
+         * 0 uses the number of hardware threads.
+         */
+        unsigned thread_count = 0;
+    };
+
+    /**
+     * @brief Writes @a grid as a single-band float32 GeoTIFF file.
+     *
+     * The CRS, units and the grid's position are written as GeoTIFF
+     * tags and geo keys. Grids whose rows run east and columns run south
+     * are stored with ModelPixelScale and ModelTiepoint, all other grids
+     * with ModelTransformation. Unknown elevations are marked with
+     * GDAL's no-data tag.
+     */
+    void write_geotiff(const std::filesystem::path& path,
+                       const IGrid& grid,
+                       const GeoTiffWriteOptions& options = {});
+}
@@ -0,0 +1,123 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GeoTiffMetadata.hpp"
+
+#include <algorithm>
+#include <span>
+#include "TiffDirectory.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        void copy_doubles(const std::vector<double>& values,
+                          std::span<double> result)
+        {
+            std::copy_n(values.begin(), std::min(values.size(), result.size()),
+                        result.begin());
+        }
+
+        /**
+         * Returns the string at @a offset in GeoAsciiParams without the
+         * '|' that terminates it.
+         */
+        std::string get_ascii_param(const std::string& params,
+                                    size_t offset, size_t count)
+        {
+            if (offset >= params.size())
+                return {};
+            auto result = params.substr(offset, count);
+            if (!result.empty() && result.back() == '|')
+                result.pop_back();
+            return result;
+        }
+
+        void read_geo_keys(const TiffDirectory& directory,
+                           GeoTiffMetadata& metadata)
+        {
+            const auto keys = directory.get_uints(TiffTag::GEO_KEY_DIRECTORY);
+            const auto ascii_params = directory.get_string(TiffTag::GEO_ASCII_PARAMS);
+            // The first four values are the directory's header.
+            for (size_t i = 4; i + 3 < keys.size(); i += 4)
+            {
+                const auto key = keys[i];
+                const auto location = keys[i + 1];
+                const auto count = keys[i + 2];
+                const auto value = keys[i + 3];
+
+                if (location == TiffTag::GEO_ASCII_PARAMS)
+                {
+                    auto str = get_ascii_param(ascii_params, value, count);
+                    if (key == GeoKey::CITATION)
+                        metadata.citation = std::move(str);
+                    else if (key == GeoKey::GEOG_CITATION)
+                        metadata.geog_citation = std::move(str);
+                    else if (key == GeoKey::PROJECTED_CITATION)
+                        metadata.projected_citation = std::move(str);
+                    else if (key == GeoKey::VERTICAL_CITATION)
+                        metadata.vertical_citation = std::move(str);
+                    continue;
+                }
+
+                if (location != 0)
+                    continue;
+
+                switch (key)
+                {
+                case GeoKey::GEODETIC_CRS:
+                    metadata.geodetic_crs = int(value);
+                    break;
+                case GeoKey::PROJECTED_CRS:
+                    metadata.projected_crs = int(value);
+                    break;
+                case GeoKey::PROJECTED_LINEAR_UNITS:
+                    metadata.projected_linear_units = int(value);
+                    break;
+                case GeoKey::VERTICAL_CRS:
+                    metadata.vertical_crs = int(value);
+                    break;
+                case GeoKey::VERTICAL_UNITS:
+                    metadata.vertical_units = int(value);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+
+    std::optional<GeoTiffMetadata>
+    read_geotiff_metadata(const TiffDirectory& directory)
+    {
+        if (!directory.find(TiffTag::GEO_KEY_DIRECTORY)
+            && !directory.find(TiffTag::MODEL_TIE_POINT)
+            && !directory.find(TiffTag::MODEL_PIXEL_SCALE)
+            && !directory.find(TiffTag::MODEL_TRANSFORMATION))
+        {
+            return {};
+        }
+
+        GeoTiffMetadata result;
+        copy_doubles(directory.get_doubles(TiffTag::MODEL_TIE_POINT),
+                     result.model_tie_point);
+        copy_doubles(directory.get_doubles(TiffTag::MODEL_PIXEL_SCALE),
+                     result.model_pixel_scale);
+        if (const auto matrix = directory.get_doubles(TiffTag::MODEL_TRANSFORMATION);
+            matrix.size() == 16)
+        {
+            copy_doubles(matrix, result.model_transformation.emplace());
+        }
+        read_geo_keys(directory, result);
+        result.gdal_metadata = directory.get_string(TiffTag::GDAL_METADATA);
+        result.date_time = directory.get_string(TiffTag::DATE_TIME);
+        result.artist = directory.get_string(TiffTag::ARTIST);
+        result.host_computer = directory.get_string(TiffTag::HOST_COMPUTER);
+        result.software = directory.get_string(TiffTag::SOFTWARE);
+        return result;
+    }
+}
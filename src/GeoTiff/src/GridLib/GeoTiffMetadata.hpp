@@ -0,0 +1,76 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace GridLib
+{
+    class TiffDirectory;
+
+    namespace GeoKey
+    {
+        constexpr uint16_t MODEL_TYPE = 1024;
+        constexpr uint16_t RASTER_TYPE = 1025;
+        constexpr uint16_t CITATION = 1026;
+        constexpr uint16_t GEODETIC_CRS = 2048;
+        constexpr uint16_t GEOG_CITATION = 2049;
+        constexpr uint16_t GEOG_ANGULAR_UNITS = 2054;
+        constexpr uint16_t PROJECTED_CRS = 3072;
+        constexpr uint16_t PROJECTED_CITATION = 3073;
+        constexpr uint16_t PROJECTED_LINEAR_UNITS = 3076;
+        constexpr uint16_t VERTICAL_CRS = 4096;
+        constexpr uint16_t VERTICAL_CITATION = 4097;
+        constexpr uint16_t VERTICAL_UNITS = 4099;
+    }
+
+    /**
+     * @brief The geo key value for user-defined codes. Codes that don't
+     *  fit in a geo key are written as "(EPSG:<code>)" at the end of the
+     *  key's citation.
+     */
+    constexpr uint16_t USER_DEFINED_CODE = 32767;
+
+    /**
+     * @brief The GeoTIFF tags and geo keys that GridLib uses.
+     */
+    struct GeoTiffMetadata
+    {
+        std::array<double, 6> model_tie_point = {};
+        std::array<double, 3> model_pixel_scale = {};
+        /**
+         * @brief The row-major matrix that maps raster coordinates
+         *  (column, row, 0, 1) to model coordinates.
+         */
+        std::optional<std::array<double, 16>> model_transformation;
+        int geodetic_crs = 0;
+        int projected_crs = 0;
+        int vertical_crs = 0;
+        int projected_linear_units = 0;
+        int vertical_units = 0;
+        std::string citation;
+        std::string geog_citation;
+        std::string projected_citation;
+        std::string vertical_citation;
+        std::string gdal_metadata;
+        std::string date_time;
+        std::string artist;
+        std::string host_computer;
+        std::string software;
+    };
+
+    /**
+     * @brief Reads the GeoTIFF metadata in @a directory.
+     *
+     * Returns nothing if the directory has none of the GeoTIFF tags.
+     */
+    [[nodiscard]] std::optional<GeoTiffMetadata>
+    read_geotiff_metadata(const TiffDirectory& directory);
+}
@@ -7,27 +7,26 @@
 //****************************************************************************
 #include "GridLib/ReadGeoTiff.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstring>
+#include <iterator>
+#include <optional>
 #include <Yimage/ReadImage.hpp>
-#include <Yimage/Tiff/GeoTiffMetadata.hpp>
 #include <Yimage/Tiff/ReadTiff.hpp>
 #include "GridLib/Utilities/CoordinateSystem.hpp"
+#include "GridLib/Utilities/MemoryMappedFile.hpp"
 #include "GridLib/Utilities/ReadOnlyStreamBuffer.hpp"
+#include "GeoTiffMetadata.hpp"
+#include "TiffDirectory.hpp"
+#include "TiffRaster.hpp"
 
 namespace GridLib
 {
     namespace
     {
-        void replace_nans(Grid& grid, float value)
-        {
-            for (auto row : grid.values())
-            {
-                std::ranges::replace_if(row,
-                                        [](float f) { return std::isnan(f); }, value);
-            }
-        }
-
-        Unit get_horizontal_unit(const Yimage::GeoTiffMetadata& metadata)
+        Unit get_horizontal_unit(const GeoTiffMetadata& metadata)
         {
             if (metadata.projected_linear_units)
                 return epsg_unit_to_unit(metadata.projected_linear_units);
@@ -38,7 +37,7 @@ namespace GridLib
             return epsg_crs_to_horizontal_unit(epsg);
         }
 
-        Unit get_vertical_unit(const Yimage::GeoTiffMetadata& metadata)
+        Unit get_vertical_unit(const GeoTiffMetadata& metadata)
         {
             if (metadata.vertical_units)
                 return epsg_unit_to_unit(metadata.vertical_units);
@@ -51,7 +50,7 @@ namespace GridLib
             return epsg_crs_to_vertical_unit(epsg);
         }
 
-        Xyz::Vector2D get_tie_point(const Yimage::GeoTiffMetadata& metadata)
+        Xyz::Vector2D get_tie_point(const GeoTiffMetadata& metadata)
         {
             return {
                 metadata.model_tie_point[1],
@@ -59,7 +58,7 @@ namespace GridLib
             };
         }
 
-        Xyz::Vector3D get_location(const Yimage::GeoTiffMetadata& metadata)
+        Xyz::Vector3D get_location(const GeoTiffMetadata& metadata)
         {
             return {
                 metadata.model_tie_point[3],
@@ -68,118 +67,264 @@ namespace GridLib
             };
         }
 
-        Crs get_crs(const Yimage::GeoTiffMetadata& metadata)
+        /**
+         * Returns the code at the end of @a citation if @a code is
+         * user-defined, and removes it from @a citation. Codes that don't
+         * fit in a geo key are written like this by write_geotiff.
+         */
+        int get_crs_code(int code, std::string& citation)
+        {
+            if (code != USER_DEFINED_CODE || !citation.ends_with(')'))
+                return code;
+
+            constexpr std::string_view PREFIX = "(EPSG:";
+            const auto pos = citation.rfind(PREFIX);
+            if (pos == std::string::npos)
+                return code;
+
+            const auto first = citation.data() + pos + PREFIX.size();
+            const auto last = citation.data() + citation.size() - 1;
+            int value;
+            if (const auto [ptr, ec] = std::from_chars(first, last, value);
+                ec != std::errc() || ptr != last)
+            {
+                return code;
+            }
+
+            citation.erase(pos > 0 && citation[pos - 1] == ' ' ? pos - 1 : pos);
+            return value;
+        }
+
+        Crs get_crs(const GeoTiffMetadata& metadata)
         {
             Crs result;
 
             if (metadata.projected_crs != 0)
             {
                 result.type = CrsType::PROJECTED;
-                result.code = metadata.projected_crs;
-                result.library = CrsLibrary::EPSG;
                 result.citation = metadata.projected_citation;
+                result.code = get_crs_code(metadata.projected_crs, result.citation);
+                result.library = CrsLibrary::EPSG;
             }
             else if (metadata.geodetic_crs != 0)
             {
                 result.type = CrsType::GEOGRAPHIC;
-                result.code = metadata.geodetic_crs;
-                result.library = CrsLibrary::EPSG;
                 result.citation = metadata.geog_citation;
+                result.code = get_crs_code(metadata.geodetic_crs, result.citation);
+                result.library = CrsLibrary::EPSG;
             }
 
-            result.vertical_code = metadata.vertical_crs;
+            auto vertical_citation = metadata.vertical_citation;
+            result.vertical_code = get_crs_code(metadata.vertical_crs, vertical_citation);
 
             return result;
         }
 
-        Grid create_grid(const Yimage::Image& img)
+        /**
+         * Sets the axes and location from the ModelTransformation tag.
+         * GeoTIFF's raster coordinates are (column, row), while the
+         * grid's are (row, column).
+         */
+        void set_transformation(SpatialInfo& model,
+                                const std::array<double, 16>& m)
         {
-            const auto metadata = dynamic_cast<const Yimage::GeoTiffMetadata*>(img.metadata());
-            if (!metadata || img.pixel_type() != Yimage::PixelType::MONO_FLOAT_32)
-                return {};
-
-            std::vector<float> elevations(img.width());
-
-            Grid result(Size{img.height(), img.width()});
-            for (size_t i = 0; i < img.height(); ++i)
-            {
-                auto [src, src_end] = img.row(i);
-                std::copy(src, src_end, reinterpret_cast<unsigned char*>(elevations.data()));
-                const auto dst = result.values().row(i);
-                std::copy(elevations.begin(), elevations.end(), dst.begin());
-            }
-
-            replace_nans(result, UNKNOWN_ELEVATION);
-
-            const auto tie_point = get_tie_point(*metadata);
-
-            auto& model = result.spatial_info();
-
-            model.tie_point = get_tie_point(*metadata);
-
-            const auto location = get_location(*metadata);
-            model.set_location(location);
-
-            std::vector<SpatialTiePoint> spatial_ties;
-
-            const auto crs = get_crs(*metadata);
-            model.crs = crs;
-            spatial_ties.push_back({tie_point, location, crs});
+            model.tie_point = {0.0, 0.0};
+            model.set_location({m[3], m[7], m[11]});
+            model.set_row_axis({m[0], m[4], m[8]});
+            model.set_column_axis({m[1], m[5], m[9]});
+            if (m[10] != 0)
+                model.set_vertical_axis({m[2], m[6], m[10]});
+            else
+                model.set_vertical_axis({0.0, 0.0, 1.0});
+        }
 
-            model.extra_tie_points = std::move(spatial_ties);
+        void set_pixel_scale(SpatialInfo& model, const GeoTiffMetadata& metadata)
+        {
+            model.tie_point = get_tie_point(metadata);
+            model.set_location(get_location(metadata));
 
-            auto xs = metadata->model_pixel_scale[0];
+            auto xs = metadata.model_pixel_scale[0];
             if (xs == 0)
                 xs = 1.0;
             model.set_row_axis({xs, 0.0, 0.0});
 
-            auto ys = metadata->model_pixel_scale[1];
+            auto ys = metadata.model_pixel_scale[1];
             if (ys == 0)
                 ys = 1.0;
             model.set_column_axis({0.0, -ys, 0.0});
 
-            auto zs = metadata->model_pixel_scale[2];
+            auto zs = metadata.model_pixel_scale[2];
             if (zs == 0)
                 zs = 1.0;
             model.set_vertical_axis({0.0, 0.0, zs});
+        }
 
-            model.horizontal_unit = get_horizontal_unit(*metadata);
-            model.vertical_unit = get_vertical_unit(*metadata);
-
-            if (!metadata->citation.empty())
-                model.information.emplace_back("citation", metadata->citation);
-            if (!metadata->gdal_metadata.empty())
-                model.information.emplace_back("gdal", metadata->gdal_metadata);
-            if (!metadata->date_time.empty())
-                model.information.emplace_back("date", metadata->date_time);
-            if (!metadata->artist.empty())
-                model.information.emplace_back("artist", metadata->artist);
-            if (!metadata->host_computer.empty())
-                model.information.emplace_back("host_computer", metadata->host_computer);
-            if (!metadata->software.empty())
-                model.information.emplace_back("software", metadata->software);
+        void set_spatial_info(SpatialInfo& model, const GeoTiffMetadata& metadata)
+        {
+            if (metadata.model_transformation)
+                set_transformation(model, *metadata.model_transformation);
+            else
+                set_pixel_scale(model, metadata);
 
+            const auto crs = get_crs(metadata);
+            model.crs = crs;
+            model.extra_tie_points = {{model.tie_point, model.location(), crs}};
+
+            model.horizontal_unit = get_horizontal_unit(metadata);
+            model.vertical_unit = get_vertical_unit(metadata);
+
+            if (!metadata.citation.empty())
+                model.information.emplace_back("citation", metadata.citation);
+            if (!metadata.gdal_metadata.empty())
+                model.information.emplace_back("gdal", metadata.gdal_metadata);
+            if (!metadata.date_time.empty())
+                model.information.emplace_back("date", metadata.date_time);
+            if (!metadata.artist.empty())
+                model.information.emplace_back("artist", metadata.artist);
+            if (!metadata.host_computer.empty())
+                model.information.emplace_back("host_computer", metadata.host_computer);
+            if (!metadata.software.empty())
+                model.information.emplace_back("software", metadata.software);
+        }
+
+        /**
+         * Moves the grid's origin to @a origin, i.e. adjusts the spatial
+         * information of a grid that only holds the part of the image
+         * that starts at @a origin.
+         */
+        void move_origin(SpatialInfo& model, const Index& origin)
+        {
+            const Xyz::Vector2D offset(static_cast<double>(origin.rows),
+                                       static_cast<double>(origin.columns));
+            const auto d = offset - model.tie_point;
+            model.set_location(model.location()
+                               + d[0] * model.column_axis()
+                               + d[1] * model.row_axis());
+            model.tie_point = {0.0, 0.0};
+            for (auto& tie_point : model.extra_tie_points)
+                tie_point.grid_point = tie_point.grid_point - offset;
+        }
+
+        /**
+         * Decodes the part of the image inside @a extent with Yimage.
+         * Used for compressions that read_tiff_raster doesn't support,
+         * e.g. ZSTD, LZMA and JPEG. Only 32-bit floating point images
+         * are read.
+         */
+        Grid read_yimage_raster(std::string_view data,
+                                const TiffRasterInfo& raster,
+                                const Extent& extent)
+        {
+            ReadOnlyStreamBuffer stream_buffer(data.data(), data.size());
+            std::istream stream(&stream_buffer);
+            const auto img = Yimage::read_tiff(stream);
+            if (img.pixel_type() != Yimage::PixelType::MONO_FLOAT_32
+                || img.width() != raster.width
+                || img.height() != raster.height)
+            {
+                return {};
+            }
+
+            const auto no_data = raster.no_data
+                                     ? float(*raster.no_data)
+                                     : std::nanf("");
+            const auto [row0, col0] = extent.origin;
+            std::vector<float> elevations(extent.size.columns);
+            Grid result(extent.size);
+            for (size_t i = 0; i < extent.size.rows; ++i)
+            {
+                const auto [src, src_end] = img.row(row0 + i);
+                std::memcpy(elevations.data(), src + col0 * sizeof(float),
+                            elevations.size() * sizeof(float));
+                std::ranges::transform(
+                    elevations, result.values().row(i).begin(),
+                    [&](float v)
+                    {
+                        return std::isnan(v) || v == no_data
+                                   ? UNKNOWN_ELEVATION
+                                   : float(v * raster.scale + raster.offset);
+                    });
+            }
+            return result;
+        }
+
+        Grid create_grid(std::string_view data,
+                         const std::optional<Extent>& window = {})
+        {
+            const TiffDirectory directory(data);
+            const auto metadata = read_geotiff_metadata(directory);
+            if (!metadata)
+                return {};
+
+            const auto raster = get_tiff_raster_info(directory);
+            const Size image_size(raster.height, raster.width);
+            const auto extent = window ? clamp(*window, image_size)
+                                       : Extent{{0, 0}, image_size};
+            Grid result;
+            if (is_supported_compression(raster))
+            {
+                if (!is_supported_raster(raster))
+                    return {};
+                result = Grid(extent.size);
+                read_tiff_raster(data, raster, extent, result.values());
+            }
+            else
+            {
+                result = read_yimage_raster(data, raster, extent);
+                if (result.empty())
+                    return {};
+            }
+
+            set_spatial_info(result.spatial_info(), *metadata);
+            if (window)
+                move_origin(result.spatial_info(), extent.origin);
             return result;
         }
     }
 
     Grid read_geotiff(std::istream& stream)
     {
-        const auto img = Yimage::read_tiff(stream);
-        return create_grid(img);
+        const std::string data(std::istreambuf_iterator<char>(stream), {});
+        return create_grid(data);
     }
 
     Grid read_geotiff(const void* buffer, size_t size)
     {
-        ReadOnlyStreamBuffer stream_buffer(static_cast<const char*>(buffer), size);
-        std::istream stream(&stream_buffer);
-        return read_geotiff(stream);
+        return create_grid({static_cast<const char*>(buffer), size});
+    }
+
+    Grid read_geotiff(const void* buffer, size_t size, const Extent& window)
+    {
+        return create_grid({static_cast<const char*>(buffer), size}, window);
     }
 
     Grid read_geotiff(const std::filesystem::path& path)
     {
-        const auto img = Yimage::read_tiff(path);
-        return create_grid(img);
+        const MemoryMappedFile file(path);
+        return create_grid(file.view());
+    }
+
+    Grid read_geotiff(const std::filesystem::path& path, const Extent& window)
+    {
+        const MemoryMappedFile file(path);
+        return create_grid(file.view(), window);
+    }
+
+    GridInfo read_geotiff_info(const std::filesystem::path& path)
+    {
+        const MemoryMappedFile file(path);
+        const TiffDirectory directory(file.view());
+        const auto metadata = read_geotiff_metadata(directory);
+        if (!metadata)
+            return {};
+
+        GridInfo result;
+        result.size = {
+            size_t(directory.get_uint(TiffTag::IMAGE_LENGTH).value_or(0)),
+            size_t(directory.get_uint(TiffTag::IMAGE_WIDTH).value_or(0))
+        };
+        set_spatial_info(result.spatial_info, *metadata);
+        return result;
     }
 
     bool is_tiff(const std::filesystem::path& path)
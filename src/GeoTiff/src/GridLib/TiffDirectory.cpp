@@ -0,0 +1,247 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "TiffDirectory.hpp"
+
+#include "GridLib/GridLibException.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        enum TiffType : uint16_t
+        {
+            BYTE = 1, ASCII = 2, SHORT = 3, LONG = 4, RATIONAL = 5,
+            SBYTE = 6, UNDEFINED = 7, SSHORT = 8, SLONG = 9, SRATIONAL = 10,
+            FLOAT = 11, DOUBLE = 12, IFD = 13, LONG8 = 16, SLONG8 = 17,
+            IFD8 = 18
+        };
+
+        size_t get_type_size(uint16_t type)
+        {
+            switch (type)
+            {
+            case BYTE:
+            case ASCII:
+            case SBYTE:
+            case UNDEFINED:
+                return 1;
+            case SHORT:
+            case SSHORT:
+                return 2;
+            case LONG:
+            case SLONG:
+            case FLOAT:
+            case IFD:
+                return 4;
+            case RATIONAL:
+            case SRATIONAL:
+            case DOUBLE:
+            case LONG8:
+            case SLONG8:
+            case IFD8:
+                return 8;
+            default:
+                return 0;
+            }
+        }
+
+        std::string_view get_range(std::string_view data,
+                                    uint64_t offset, uint64_t size)
+        {
+            if (offset > data.size() || size > data.size() - offset)
+                GRIDLIB_THROW("TIFF file is truncated.");
+            return data.substr(size_t(offset), size_t(size));
+        }
+    }
+
+    TiffDirectory::TiffDirectory(std::string_view file_data)
+        : data_(file_data)
+    {
+        const auto header = get_range(data_, 0, 8);
+        if (header.starts_with("MM"))
+            big_endian_ = true;
+        else if (!header.starts_with("II"))
+            GRIDLIB_THROW("Not a TIFF file.");
+
+        const auto magic = read_tiff_value<uint16_t>(header.data() + 2, big_endian_);
+        const bool big_tiff = magic == 43;
+        if (magic != 42 && !big_tiff)
+            GRIDLIB_THROW("Not a TIFF file.");
+
+        // Classic TIFF uses 32-bit offsets and counts, BigTIFF 64-bit.
+        const size_t offset_size = big_tiff ? 8 : 4;
+        const size_t entry_size = big_tiff ? 20 : 12;
+        const auto read_offset = [&](const char* p) -> uint64_t
+        {
+            if (big_tiff)
+                return read_tiff_value<uint64_t>(p, big_endian_);
+            return read_tiff_value<uint32_t>(p, big_endian_);
+        };
+
+        const auto ifd_offset = big_tiff
+                                    ? read_offset(get_range(data_, 8, 8).data())
+                                    : read_offset(header.data() + 4);
+        const auto count_size = big_tiff ? 8 : 2;
+        const auto count_data = get_range(data_, ifd_offset, count_size);
+        const auto entry_count = big_tiff
+                                     ? read_tiff_value<uint64_t>(count_data.data(), big_endian_)
+                                     : read_tiff_value<uint16_t>(count_data.data(), big_endian_);
+        if (entry_count > data_.size())
+            GRIDLIB_THROW("TIFF file is truncated.");
+        const auto entries = get_range(data_, ifd_offset + count_size,
+                                       entry_count * entry_size);
+
+        entries_.reserve(size_t(entry_count));
+        for (size_t i = 0; i < entry_count; ++i)
+        {
+            const auto p = entries.data() + i * entry_size;
+            TiffEntry entry;
+            entry.tag = read_tiff_value<uint16_t>(p, big_endian_);
+            entry.type = read_tiff_value<uint16_t>(p + 2, big_endian_);
+            entry.count = read_offset(p + 4);
+            const auto type_size = get_type_size(entry.type);
+            if (type_size == 0)
+                continue;
+            if (entry.count > data_.size())
+                GRIDLIB_THROW("TIFF file is truncated.");
+
+            const auto size = entry.count * type_size;
+            const auto value = p + 4 + offset_size;
+            if (size <= offset_size)
+                entry.data = {value, size_t(size)};
+            else
+                entry.data = get_range(data_, read_offset(value), size);
+            entries_.push_back(entry);
+        }
+    }
+
+    std::string_view TiffDirectory::file_data() const
+    {
+        return data_;
+    }
+
+    bool TiffDirectory::is_big_endian() const
+    {
+        return big_endian_;
+    }
+
+    const TiffEntry* TiffDirectory::find(uint16_t tag) const
+    {
+        for (const auto& entry : entries_)
+        {
+            if (entry.tag == tag)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    std::optional<uint64_t> TiffDirectory::get_uint(uint16_t tag) const
+    {
+        const auto* entry = find(tag);
+        if (!entry || entry->count == 0)
+            return {};
+        return get_uint(*entry, 0);
+    }
+
+    std::vector<uint64_t> TiffDirectory::get_uints(uint16_t tag) const
+    {
+        std::vector<uint64_t> result;
+        const auto* entry = find(tag);
+        if (!entry)
+            return result;
+
+        result.reserve(size_t(entry->count));
+        for (size_t i = 0; i < entry->count; ++i)
+            result.push_back(get_uint(*entry, i));
+        return result;
+    }
+
+    std::vector<double> TiffDirectory::get_doubles(uint16_t tag) const
+    {
+        std::vector<double> result;
+        const auto* entry = find(tag);
+        if (!entry)
+            return result;
+
+        result.reserve(size_t(entry->count));
+        for (size_t i = 0; i < entry->count; ++i)
+            result.push_back(get_number(*entry, i));
+        return result;
+    }
+
+    std::string TiffDirectory::get_string(uint16_t tag) const
+    {
+        const auto* entry = find(tag);
+        if (!entry)
+            return {};
+
+        auto str = entry->data;
+        while (!str.empty() && str.back() == '\0')
+            str.remove_suffix(1);
+        return std::string(str);
+    }
+
+    uint64_t TiffDirectory::get_uint(const TiffEntry& entry,
+                                     size_t index) const
+    {
+        const auto p = entry.data.data() + index * get_type_size(entry.type);
+        switch (entry.type)
+        {
+        case SHORT:
+            return read_tiff_value<uint16_t>(p, big_endian_);
+        case LONG:
+        case IFD:
+            return read_tiff_value<uint32_t>(p, big_endian_);
+        case LONG8:
+        case IFD8:
+            return read_tiff_value<uint64_t>(p, big_endian_);
+        default:
+            return uint64_t(get_number(entry, index));
+        }
+    }
+
+    double TiffDirectory::get_number(const TiffEntry& entry,
+                                     size_t index) const
+    {
+        const auto p = entry.data.data() + index * get_type_size(entry.type);
+        switch (entry.type)
+        {
+        case BYTE:
+        case UNDEFINED:
+            return uint8_t(*p);
+        case SBYTE:
+            return int8_t(*p);
+        case SHORT:
+            return read_tiff_value<uint16_t>(p, big_endian_);
+        case SSHORT:
+            return read_tiff_value<int16_t>(p, big_endian_);
+        case LONG:
+        case IFD:
+            return read_tiff_value<uint32_t>(p, big_endian_);
+        case SLONG:
+            return read_tiff_value<int32_t>(p, big_endian_);
+        case RATIONAL:
+            return double(read_tiff_value<uint32_t>(p, big_endian_))
+                   / read_tiff_value<uint32_t>(p + 4, big_endian_);
+        case SRATIONAL:
+            return double(read_tiff_value<int32_t>(p, big_endian_))
+                   / read_tiff_value<int32_t>(p + 4, big_endian_);
+        case FLOAT:
+            return read_tiff_value<float>(p, big_endian_);
+        case DOUBLE:
+            return read_tiff_value<double>(p, big_endian_);
+        case LONG8:
+        case IFD8:
+            return double(read_tiff_value<uint64_t>(p, big_endian_));
+        case SLONG8:
+            return double(read_tiff_value<int64_t>(p, big_endian_));
+        default:
+            GRIDLIB_THROW("Unsupported TIFF type: " + std::to_string(entry.type));
+        }
+    }
+}
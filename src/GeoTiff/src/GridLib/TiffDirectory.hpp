@@ -0,0 +1,117 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GridLib
+{
+    namespace TiffTag
+    {
+        constexpr uint16_t IMAGE_WIDTH = 256;
+        constexpr uint16_t IMAGE_LENGTH = 257;
+        constexpr uint16_t BITS_PER_SAMPLE = 258;
+        constexpr uint16_t COMPRESSION = 259;
+        constexpr uint16_t PHOTOMETRIC = 262;
+        constexpr uint16_t STRIP_OFFSETS = 273;
+        constexpr uint16_t SAMPLES_PER_PIXEL = 277;
+        constexpr uint16_t ROWS_PER_STRIP = 278;
+        constexpr uint16_t STRIP_BYTE_COUNTS = 279;
+        constexpr uint16_t PLANAR_CONFIGURATION = 284;
+        constexpr uint16_t SOFTWARE = 305;
+        constexpr uint16_t DATE_TIME = 306;
+        constexpr uint16_t ARTIST = 315;
+        constexpr uint16_t HOST_COMPUTER = 316;
+        constexpr uint16_t PREDICTOR = 317;
+        constexpr uint16_t TILE_WIDTH = 322;
+        constexpr uint16_t TILE_LENGTH = 323;
+        constexpr uint16_t TILE_OFFSETS = 324;
+        constexpr uint16_t TILE_BYTE_COUNTS = 325;
+        constexpr uint16_t SAMPLE_FORMAT = 339;
+        constexpr uint16_t MODEL_PIXEL_SCALE = 33550;
+        constexpr uint16_t MODEL_TIE_POINT = 33922;
+        constexpr uint16_t MODEL_TRANSFORMATION = 34264;
+        constexpr uint16_t GEO_KEY_DIRECTORY = 34735;
+        constexpr uint16_t GEO_DOUBLE_PARAMS = 34736;
+        constexpr uint16_t GEO_ASCII_PARAMS = 34737;
+        constexpr uint16_t GDAL_METADATA = 42112;
+        constexpr uint16_t GDAL_NODATA = 42113;
+    }
+
+    struct TiffEntry
+    {
+        uint16_t tag = 0;
+        uint16_t type = 0;
+        uint64_t count = 0;
+        /// The entry's values, in the file's byte order.
+        std::string_view data;
+    };
+
+    /**
+     * @brief The tags in the first image file directory (IFD) of a
+     *  classic or BigTIFF file.
+     *
+     * Entries refer directly to the file's data, which must outlive the
+     * directory.
+     */
+    class TiffDirectory
+    {
+    public:
+        explicit TiffDirectory(std::string_view file_data);
+
+        [[nodiscard]] std::string_view file_data() const;
+
+        [[nodiscard]] bool is_big_endian() const;
+
+        [[nodiscard]] const TiffEntry* find(uint16_t tag) const;
+
+        [[nodiscard]] std::optional<uint64_t> get_uint(uint16_t tag) const;
+
+        [[nodiscard]] std::vector<uint64_t> get_uints(uint16_t tag) const;
+
+        [[nodiscard]] std::vector<double> get_doubles(uint16_t tag) const;
+
+        /**
+         * @brief Returns the value of an ASCII tag without its
+         *  terminating null character.
+         */
+        [[nodiscard]] std::string get_string(uint16_t tag) const;
+    private:
+        [[nodiscard]] uint64_t get_uint(const TiffEntry& entry,
+                                        size_t index) const;
+
+        [[nodiscard]] double get_number(const TiffEntry& entry,
+                                        size_t index) const;
+
+        std::string_view data_;
+        bool big_endian_ = false;
+        std::vector<TiffEntry> entries_;
+    };
+
+    /**
+     * @brief Reads a value of type @a T from @a p, which is in big-endian
+     *  byte order if @a big_endian is true and little-endian otherwise.
+     */
+    template <typename T>
+    T read_tiff_value(const char* p, bool big_endian)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, p, sizeof(T));
+        if (big_endian != (std::endian::native == std::endian::big))
+            std::reverse(std::begin(bytes), std::end(bytes));
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+}
@@ -0,0 +1,622 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "TiffRaster.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <zlib.h>
+#include "GridLib/GridLibException.hpp"
+#include "GridLib/GridMemberTypes.hpp"
+#include "GridLib/Utilities/FloatFromChars.hpp"
+#include "TiffDirectory.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        enum Compression : unsigned
+        {
+            NONE = 1,
+            LZW = 5,
+            DEFLATE = 8,
+            PACKBITS = 32773,
+            ADOBE_DEFLATE = 32946
+        };
+
+        enum Predictor : unsigned
+        {
+            NO_PREDICTOR = 1,
+            HORIZONTAL = 2,
+            FLOATING_POINT = 3
+        };
+
+        enum SampleFormat : unsigned
+        {
+            UINT = 1,
+            INT = 2,
+            IEEEFP = 3
+        };
+
+        size_t get_block_count(size_t size, size_t block_size)
+        {
+            return (size + block_size - 1) / block_size;
+        }
+
+        /**
+         * Returns the number of samples per pixel in each block. With
+         * separate planes, each block only has samples from one band.
+         */
+        size_t get_block_samples(const TiffRasterInfo& info)
+        {
+            return info.planar_separate ? 1 : info.samples_per_pixel;
+        }
+
+        std::optional<double> parse_double(std::string_view str)
+        {
+            while (!str.empty() && std::isspace(uint8_t(str.front())))
+                str.remove_prefix(1);
+            while (!str.empty() && std::isspace(uint8_t(str.back())))
+                str.remove_suffix(1);
+            if (!str.empty() && str.front() == '+')
+                str.remove_prefix(1);
+
+            double value;
+            const auto [ptr, ec] = float_from_chars(str.data(), str.data() + str.size(),
+                                                    value);
+            if (ec != std::errc() || ptr != str.data() + str.size())
+                return {};
+            return value;
+        }
+
+        /**
+         * Returns the value of the first band's item with the given
+         * role in GDAL's XML metadata, e.g.
+         * <Item name="SCALE" sample="0" role="scale">0.1</Item>.
+         */
+        std::optional<double> get_gdal_band_value(std::string_view xml,
+                                                  std::string_view role)
+        {
+            const auto role_attribute = "role=\"" + std::string(role) + "\"";
+            for (auto pos = xml.find("<Item"); pos != std::string_view::npos;
+                 pos = xml.find("<Item", pos + 1))
+            {
+                const auto tag_end = xml.find('>', pos);
+                const auto item_end = xml.find("</Item>", pos);
+                if (tag_end == std::string_view::npos || item_end < tag_end)
+                    break;
+
+                const auto tag = xml.substr(pos, tag_end - pos);
+                if (tag.find(role_attribute) == std::string_view::npos)
+                    continue;
+                const auto sample = tag.find("sample=\"");
+                if (sample != std::string_view::npos
+                    && tag.substr(sample + 8, 2) != "0\"")
+                {
+                    continue;
+                }
+                return parse_double(xml.substr(tag_end + 1, item_end - tag_end - 1));
+            }
+            return {};
+        }
+
+        void inflate_block(std::string_view src, std::span<char> dst)
+        {
+            z_stream stream = {};
+            if (inflateInit(&stream) != Z_OK)
+                GRIDLIB_THROW("Unable to initialize zlib.");
+
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(src.data()));
+            stream.avail_in = uInt(src.size());
+            stream.next_out = reinterpret_cast<Bytef*>(dst.data());
+            stream.avail_out = uInt(dst.size());
+            const auto result = inflate(&stream, Z_FINISH);
+            const auto remaining = stream.avail_out;
+            inflateEnd(&stream);
+            // Some writers pad the compressed data, it is sufficient
+            // that the output is complete.
+            if (result != Z_STREAM_END && remaining != 0)
+                GRIDLIB_THROW("Invalid deflate-compressed TIFF data.");
+        }
+
+        void unpack_bits(std::string_view src, std::span<char> dst)
+        {
+            size_t out = 0;
+            for (size_t i = 0; i < src.size() && out < dst.size();)
+            {
+                const auto n = int(int8_t(src[i++]));
+                if (n >= 0)
+                {
+                    const auto count = std::min({size_t(n) + 1,
+                                                 src.size() - i,
+                                                 dst.size() - out});
+                    std::copy_n(src.data() + i, count, dst.data() + out);
+                    i += size_t(n) + 1;
+                    out += count;
+                }
+                else if (n != -128 && i < src.size())
+                {
+                    const auto count = std::min(size_t(1 - n), dst.size() - out);
+                    std::fill_n(dst.data() + out, count, src[i++]);
+                    out += count;
+                }
+            }
+            if (out != dst.size())
+                GRIDLIB_THROW("Invalid PackBits-compressed TIFF data.");
+        }
+
+        void decode_lzw(std::string_view src, std::span<char> dst)
+        {
+            constexpr uint32_t CLEAR_CODE = 256;
+            constexpr uint32_t END_CODE = 257;
+            constexpr uint32_t FIRST_CODE = 258;
+            constexpr uint32_t MAX_CODES = 4096;
+            constexpr uint32_t NO_CODE = MAX_CODES;
+
+            struct Entry
+            {
+                uint32_t prefix;
+                uint32_t length;
+                char first;
+                char last;
+            };
+
+            thread_local std::vector<Entry> table(MAX_CODES);
+            for (uint32_t i = 0; i < 256; ++i)
+                table[i] = {NO_CODE, 1, char(i), char(i)};
+
+            size_t out = 0;
+            const auto write = [&](uint32_t code)
+            {
+                const auto length = table[code].length;
+                if (length > dst.size() - out)
+                    GRIDLIB_THROW("Invalid LZW-compressed TIFF data.");
+                auto p = dst.data() + out + length;
+                for (auto c = code; c != NO_CODE; c = table[c].prefix)
+                    *--p = table[c].last;
+                out += length;
+            };
+
+            uint64_t bits = 0;
+            unsigned bit_count = 0;
+            size_t pos = 0;
+            unsigned width = 9;
+            uint32_t next = FIRST_CODE;
+            uint32_t prev = NO_CODE;
+            while (out < dst.size())
+            {
+                while (bit_count < width && pos < src.size())
+                {
+                    bits = (bits << 8) | uint8_t(src[pos++]);
+                    bit_count += 8;
+                }
+                if (bit_count < width)
+                    break;
+
+                const auto code = uint32_t(bits >> (bit_count - width)) & ((1u << width) - 1);
+                bit_count -= width;
+
+                if (code == END_CODE)
+                    break;
+
+                if (code == CLEAR_CODE)
+                {
+                    width = 9;
+                    next = FIRST_CODE;
+                    prev = NO_CODE;
+                    continue;
+                }
+
+                if (prev == NO_CODE)
+                {
+                    if (code >= 256)
+                        GRIDLIB_THROW("Invalid LZW-compressed TIFF data.");
+                    write(code);
+                    prev = code;
+                    continue;
+                }
+
+                if (code > next || (code == next && next == MAX_CODES))
+                    GRIDLIB_THROW("Invalid LZW-compressed TIFF data.");
+
+                if (next < MAX_CODES)
+                {
+                    const auto first = code < next ? table[code].first
+                                                   : table[prev].first;
+                    table[next] = {prev, table[prev].length + 1,
+                                   table[prev].first, first};
+                    ++next;
+                }
+                write(code);
+                prev = code;
+
+                // TIFF's LZW switches to longer codes one code early.
+                if (next + 1 >= (1u << width) && width < 12)
+                    ++width;
+            }
+
+            if (out != dst.size())
+                GRIDLIB_THROW("Invalid LZW-compressed TIFF data.");
+        }
+
+        template <typename T>
+        void undo_horizontal_predictor(std::span<char> row, size_t samples,
+                                       size_t samples_per_pixel, bool big_endian)
+        {
+            const auto stride = samples_per_pixel * sizeof(T);
+            for (size_t i = samples_per_pixel; i < samples; ++i)
+            {
+                const auto p = row.data() + i * sizeof(T);
+                const auto value = T(read_tiff_value<T>(p, big_endian)
+                                     + read_tiff_value<T>(p - stride, big_endian));
+                // Writing reverses the byte order back if necessary.
+                const auto stored = read_tiff_value<T>(
+                    reinterpret_cast<const char*>(&value), big_endian);
+                std::memcpy(p, &stored, sizeof(T));
+            }
+        }
+
+        /**
+         * Undoes the floating point predictor. The predictor stores the
+         * samples' bytes as planes, most significant byte first, and
+         * takes the difference between consecutive bytes. The result is
+         * in native byte order.
+         */
+        void undo_floating_point_predictor(std::span<char> row,
+                                           size_t samples,
+                                           size_t sample_size,
+                                           size_t samples_per_pixel,
+                                           std::vector<char>& buffer)
+        {
+            const auto size = samples * sample_size;
+            for (size_t i = samples_per_pixel; i < size; ++i)
+                row[i] = char(row[i] + row[i - samples_per_pixel]);
+
+            buffer.assign(row.begin(), row.begin() + ptrdiff_t(size));
+            for (size_t i = 0; i < samples; ++i)
+            {
+                for (size_t b = 0; b < sample_size; ++b)
+                {
+                    const auto dst = std::endian::native == std::endian::big
+                                         ? b
+                                         : sample_size - 1 - b;
+                    row[i * sample_size + dst] = buffer[b * samples + i];
+                }
+            }
+        }
+
+        void undo_predictor(std::span<char> block, size_t rows,
+                            const TiffRasterInfo& info,
+                            std::vector<char>& buffer)
+        {
+            const auto sample_size = info.bits_per_sample / 8;
+            const auto samples_per_pixel = get_block_samples(info);
+            const auto samples = info.block_width * samples_per_pixel;
+            const auto row_size = samples * sample_size;
+            for (size_t i = 0; i < rows; ++i)
+            {
+                const auto row = block.subspan(i * row_size, row_size);
+                if (info.predictor == FLOATING_POINT)
+                {
+                    undo_floating_point_predictor(row, samples, sample_size,
+                                                  samples_per_pixel, buffer);
+                    continue;
+                }
+
+                switch (sample_size)
+                {
+                case 1:
+                    undo_horizontal_predictor<uint8_t>(
+                        row, samples, samples_per_pixel, info.big_endian);
+                    break;
+                case 2:
+                    undo_horizontal_predictor<uint16_t>(
+                        row, samples, samples_per_pixel, info.big_endian);
+                    break;
+                case 4:
+                    undo_horizontal_predictor<uint32_t>(
+                        row, samples, samples_per_pixel, info.big_endian);
+                    break;
+                case 8:
+                    undo_horizontal_predictor<uint64_t>(
+                        row, samples, samples_per_pixel, info.big_endian);
+                    break;
+                default:
+                    GRIDLIB_THROW("Unsupported TIFF predictor.");
+                }
+            }
+        }
+
+        /**
+         * Returns the decompressed contents of block number @a index,
+         * which holds @a rows rows. The result is either a view of the
+         * file data or of @a block_buffer.
+         */
+        std::string_view decode_block(std::string_view file_data,
+                                      const TiffRasterInfo& info,
+                                      size_t index, size_t rows,
+                                      std::vector<char>& block_buffer,
+                                      std::vector<char>& row_buffer)
+        {
+            const auto offset = info.block_offsets[index];
+            const auto size = info.block_sizes[index];
+            if (offset > file_data.size() || size > file_data.size() - offset)
+                GRIDLIB_THROW("TIFF file is truncated.");
+            const auto src = file_data.substr(size_t(offset), size_t(size));
+
+            const auto row_size = info.block_width * get_block_samples(info)
+                                  * info.bits_per_sample / 8;
+            const auto block_size = rows * row_size;
+            if (info.compression == NONE && info.predictor == NO_PREDICTOR)
+            {
+                if (src.size() < block_size)
+                    GRIDLIB_THROW("TIFF file is truncated.");
+                return src;
+            }
+
+            block_buffer.resize(block_size);
+            const auto dst = std::span(block_buffer);
+            switch (info.compression)
+            {
+            case NONE:
+                if (src.size() < block_size)
+                    GRIDLIB_THROW("TIFF file is truncated.");
+                std::copy_n(src.data(), block_size, dst.data());
+                break;
+            case LZW:
+                decode_lzw(src, dst);
+                break;
+            case DEFLATE:
+            case ADOBE_DEFLATE:
+                inflate_block(src, dst);
+                break;
+            case PACKBITS:
+                unpack_bits(src, dst);
+                break;
+            default:
+                GRIDLIB_THROW("Unsupported TIFF compression: "
+                              + std::to_string(info.compression));
+            }
+
+            if (info.predictor != NO_PREDICTOR)
+                undo_predictor(dst, rows, info, row_buffer);
+
+            return {block_buffer.data(), block_buffer.size()};
+        }
+
+        /**
+         * Converts every @a stride'th sample of type T in @a src to
+         * elevations, applying the scale and offset and replacing
+         * NaN and no-data values with UNKNOWN_ELEVATION.
+         */
+        template <typename T>
+        void convert_row(const char* src, size_t stride, bool big_endian,
+                         const TiffRasterInfo& info, std::span<float> dst)
+        {
+            // Compare floating point samples with the no-data value
+            // converted to the sample type to avoid rounding issues.
+            using CompareType = std::conditional_t<std::is_floating_point_v<T>,
+                                                   T, double>;
+            const auto no_data = info.no_data
+                                     ? CompareType(*info.no_data)
+                                     : std::numeric_limits<CompareType>::quiet_NaN();
+            const auto scale = info.scale;
+            const auto offset = info.offset;
+            for (auto& value : dst)
+            {
+                const auto v = read_tiff_value<T>(src, big_endian);
+                src += stride;
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    if (std::isnan(v))
+                    {
+                        value = UNKNOWN_ELEVATION;
+                        continue;
+                    }
+                }
+                value = CompareType(v) == no_data
+                            ? UNKNOWN_ELEVATION
+                            : float(double(v) * scale + offset);
+            }
+        }
+
+        using ConvertRowFunc = void (*)(const char*, size_t, bool,
+                                        const TiffRasterInfo&,
+                                        std::span<float>);
+
+        ConvertRowFunc get_convert_row_func(const TiffRasterInfo& info)
+        {
+            switch (info.sample_format)
+            {
+            case UINT:
+                switch (info.bits_per_sample)
+                {
+                case 8: return convert_row<uint8_t>;
+                case 16: return convert_row<uint16_t>;
+                case 32: return convert_row<uint32_t>;
+                default: return nullptr;
+                }
+            case INT:
+                switch (info.bits_per_sample)
+                {
+                case 8: return convert_row<int8_t>;
+                case 16: return convert_row<int16_t>;
+                case 32: return convert_row<int32_t>;
+                default: return nullptr;
+                }
+            case IEEEFP:
+                switch (info.bits_per_sample)
+                {
+                case 32: return convert_row<float>;
+                case 64: return convert_row<double>;
+                default: return nullptr;
+                }
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    TiffRasterInfo get_tiff_raster_info(const TiffDirectory& directory)
+    {
+        TiffRasterInfo info;
+        info.width = size_t(directory.get_uint(TiffTag::IMAGE_WIDTH).value_or(0));
+        info.height = size_t(directory.get_uint(TiffTag::IMAGE_LENGTH).value_or(0));
+        info.bits_per_sample = unsigned(directory.get_uint(TiffTag::BITS_PER_SAMPLE).value_or(1));
+        info.sample_format = unsigned(directory.get_uint(TiffTag::SAMPLE_FORMAT).value_or(UINT));
+        info.samples_per_pixel = unsigned(directory.get_uint(TiffTag::SAMPLES_PER_PIXEL).value_or(1));
+        info.compression = unsigned(directory.get_uint(TiffTag::COMPRESSION).value_or(NONE));
+        info.predictor = unsigned(directory.get_uint(TiffTag::PREDICTOR).value_or(NO_PREDICTOR));
+        info.planar_separate = directory.get_uint(TiffTag::PLANAR_CONFIGURATION).value_or(1) == 2;
+        info.big_endian = directory.is_big_endian();
+
+        const auto gdal_metadata = directory.get_string(TiffTag::GDAL_METADATA);
+        info.scale = get_gdal_band_value(gdal_metadata, "scale").value_or(1.0);
+        info.offset = get_gdal_band_value(gdal_metadata, "offset").value_or(0.0);
+        info.no_data = parse_double(directory.get_string(TiffTag::GDAL_NODATA));
+
+        if (directory.find(TiffTag::TILE_OFFSETS))
+        {
+            info.tiled = true;
+            info.block_width = size_t(directory.get_uint(TiffTag::TILE_WIDTH).value_or(0));
+            info.block_height = size_t(directory.get_uint(TiffTag::TILE_LENGTH).value_or(0));
+            info.block_offsets = directory.get_uints(TiffTag::TILE_OFFSETS);
+            info.block_sizes = directory.get_uints(TiffTag::TILE_BYTE_COUNTS);
+        }
+        else
+        {
+            info.block_width = info.width;
+            info.block_height = size_t(directory.get_uint(TiffTag::ROWS_PER_STRIP)
+                                           .value_or(info.height));
+            info.block_height = std::min(info.block_height, info.height);
+            info.block_offsets = directory.get_uints(TiffTag::STRIP_OFFSETS);
+            info.block_sizes = directory.get_uints(TiffTag::STRIP_BYTE_COUNTS);
+        }
+
+        if (info.width != 0 && info.height != 0)
+        {
+            if (info.block_width == 0 || info.block_height == 0)
+                GRIDLIB_THROW("Invalid TIFF tile or strip size.");
+            const auto block_count = get_block_count(info.width, info.block_width)
+                                     * get_block_count(info.height, info.block_height);
+            if (info.block_offsets.size() < block_count
+                || info.block_sizes.size() < block_count)
+            {
+                GRIDLIB_THROW("TIFF file has too few tiles or strips.");
+            }
+        }
+        return info;
+    }
+
+    bool is_supported_raster(const TiffRasterInfo& info)
+    {
+        return info.samples_per_pixel >= 1
+               && get_convert_row_func(info) != nullptr;
+    }
+
+    bool is_supported_compression(const TiffRasterInfo& info)
+    {
+        switch (info.compression)
+        {
+        case NONE:
+        case LZW:
+        case DEFLATE:
+        case ADOBE_DEFLATE:
+        case PACKBITS:
+            break;
+        default:
+            return false;
+        }
+
+        return info.predictor == NO_PREDICTOR
+               || info.predictor == HORIZONTAL
+               || info.predictor == FLOATING_POINT;
+    }
+
+    void read_tiff_raster(std::string_view file_data,
+                          const TiffRasterInfo& info,
+                          Chorasmia::MutableArrayView2D<float> values)
+    {
+        read_tiff_raster(file_data, info,
+                         {{0, 0}, {info.height, info.width}},
+                         values);
+    }
+
+    void read_tiff_raster(std::string_view file_data,
+                          const TiffRasterInfo& info,
+                          const Chorasmia::Extent2D<size_t>& window,
+                          Chorasmia::MutableArrayView2D<float> values)
+    {
+        if (!is_supported_raster(info))
+            GRIDLIB_THROW("Unsupported TIFF sample type.");
+        if (!is_supported_compression(info))
+            GRIDLIB_THROW("Unsupported TIFF compression: "
+                          + std::to_string(info.compression));
+
+        const auto [row0, col0] = window.origin;
+        const auto [n_rows, n_cols] = window.size;
+        if (row0 + n_rows > info.height || col0 + n_cols > info.width)
+            GRIDLIB_THROW("The window is outside the image.");
+        if (values.dimensions() != window.size)
+            GRIDLIB_THROW("The size of the array doesn't match the window.");
+        if (n_rows == 0 || n_cols == 0)
+            return;
+
+        // After the floating point predictor the values are in native
+        // byte order.
+        const auto big_endian = info.predictor == FLOATING_POINT
+                                    ? std::endian::native == std::endian::big
+                                    : info.big_endian;
+        const auto convert = get_convert_row_func(info);
+        const auto sample_size = info.bits_per_sample / 8;
+        const auto pixel_size = get_block_samples(info) * sample_size;
+        const auto row_size = info.block_width * pixel_size;
+        const auto blocks_across = get_block_count(info.width, info.block_width);
+
+        std::vector<char> block_buffer;
+        std::vector<char> row_buffer;
+        const auto first_block_row = row0 / info.block_height;
+        const auto last_block_row = (row0 + n_rows - 1) / info.block_height;
+        const auto first_block_col = col0 / info.block_width;
+        const auto last_block_col = (col0 + n_cols - 1) / info.block_width;
+        for (auto by = first_block_row; by <= last_block_row; ++by)
+        {
+            const auto y0 = by * info.block_height;
+            const auto rows = std::min(info.block_height, info.height - y0);
+            const auto row_begin = std::max(y0, row0);
+            const auto row_end = std::min(y0 + rows, row0 + n_rows);
+            for (auto bx = first_block_col; bx <= last_block_col; ++bx)
+            {
+                const auto x0 = bx * info.block_width;
+                const auto col_begin = std::max(x0, col0);
+                const auto col_end = std::min(x0 + info.block_width,
+                                              col0 + n_cols);
+                // Tiles are always stored with their full size, even at
+                // the image's edges. The last strip only has the
+                // remaining rows.
+                const auto block = decode_block(file_data, info,
+                                                by * blocks_across + bx,
+                                                info.tiled ? info.block_height : rows,
+                                                block_buffer, row_buffer);
+                for (auto r = row_begin; r < row_end; ++r)
+                {
+                    const auto src = block.data() + (r - y0) * row_size
+                                     + (col_begin - x0) * pixel_size;
+                    const auto dst = values.row(r - row0).begin() + (col_begin - col0);
+                    convert(src, pixel_size, big_endian, info,
+                            std::span(dst, col_end - col_begin));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <Chorasmia/ArrayView2D.hpp>
+
+namespace GridLib
+{
+    class TiffDirectory;
+
+    /**
+     * @brief The layout of the pixel data in a TIFF image.
+     *
+     * Strips are treated as tiles that are as wide as the image.
+     * Only the first sample of each pixel is read. Values are
+     * multiplied by @a scale and added to @a offset, and values equal
+     * to @a no_data become UNKNOWN_ELEVATION.
+     */
+    struct TiffRasterInfo
+    {
+        size_t width = 0;
+        size_t height = 0;
+        size_t block_width = 0;
+        size_t block_height = 0;
+        bool tiled = false;
+        unsigned bits_per_sample = 0;
+        unsigned sample_format = 1;
+        unsigned samples_per_pixel = 1;
+        unsigned compression = 1;
+        unsigned predictor = 1;
+        bool planar_separate = false;
+        bool big_endian = false;
+        double scale = 1.0;
+        double offset = 0.0;
+        std::optional<double> no_data;
+        std::vector<uint64_t> block_offsets;
+        std::vector<uint64_t> block_sizes;
+    };
+
+    [[nodiscard]] TiffRasterInfo
+    get_tiff_raster_info(const TiffDirectory& directory);
+
+    /**
+     * @brief Returns true if read_tiff_raster can decode rasters with
+     *  @a info's sample type.
+     */
+    [[nodiscard]] bool is_supported_raster(const TiffRasterInfo& info);
+
+    /**
+     * @brief Returns true if read_tiff_raster can decompress rasters
+     *  with @a info's compression and predictor.
+     */
+    [[nodiscard]] bool is_supported_compression(const TiffRasterInfo& info);
+
+    /**
+     * @brief Decodes the raster described by @a info straight into
+     *  @a values, which must be as large as the image.
+     *
+     * NaN and no-data values are replaced with UNKNOWN_ELEVATION.
+     */
+    void read_tiff_raster(std::string_view file_data,
+                          const TiffRasterInfo& info,
+                          Chorasmia::MutableArrayView2D<float> values);
+
+    /**
+     * @brief Decodes the part of the raster that is inside @a window
+     *  straight into @a values, which must be as large as the window.
+     *
+     * Only the strips or tiles that intersect the window are decoded.
+     */
+    void read_tiff_raster(std::string_view file_data,
+                          const TiffRasterInfo& info,
+                          const Chorasmia::Extent2D<size_t>& window,
+                          Chorasmia::MutableArrayView2D<float> values);
+}
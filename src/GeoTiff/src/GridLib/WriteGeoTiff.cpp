@@ -0,0 +1,625 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GridLib/WriteGeoTiff.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <span>
+#include <thread>
+#include <zlib.h>
+#include "GridLib/GridLibException.hpp"
+#include "GridLib/Utilities/CoordinateSystem.hpp"
+#include "GeoTiffMetadata.hpp"
+#include "TiffDirectory.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        enum TiffType : uint16_t
+        {
+            ASCII = 2,
+            SHORT = 3,
+            LONG = 4,
+            DOUBLE = 12,
+            LONG8 = 16
+        };
+
+        constexpr uint16_t COMPRESSION_NONE = 1;
+        constexpr uint16_t COMPRESSION_DEFLATE = 8;
+        constexpr uint16_t PHOTOMETRIC_MIN_IS_BLACK = 1;
+        constexpr uint16_t PREDICTOR_FLOATING_POINT = 3;
+        constexpr uint16_t SAMPLE_FORMAT_IEEEFP = 3;
+        constexpr uint16_t MODEL_TYPE_PROJECTED = 1;
+        constexpr uint16_t MODEL_TYPE_GEOGRAPHIC = 2;
+        constexpr uint16_t RASTER_PIXEL_IS_AREA = 1;
+
+        /// The number of values in each strip when writing strips.
+        constexpr size_t STRIP_VALUES = 256 * 256;
+
+        template <typename T>
+        void append(std::string& out, T value)
+        {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /**
+         * Collects the entries of a TIFF directory and writes them, and
+         * the values that don't fit inside the entries, in native byte
+         * order.
+         */
+        class TiffDirectoryBuilder
+        {
+        public:
+            explicit TiffDirectoryBuilder(bool big_tiff)
+                : big_tiff_(big_tiff)
+            {}
+
+            template <typename T>
+            void add(uint16_t tag, uint16_t type, std::span<const T> values)
+            {
+                std::string data(values.size() * sizeof(T), '\0');
+                std::memcpy(data.data(), values.data(), data.size());
+                entries_.push_back({tag, type, values.size(), std::move(data)});
+            }
+
+            void add_short(uint16_t tag, uint16_t value)
+            {
+                add(tag, SHORT, std::span<const uint16_t>(&value, 1));
+            }
+
+            void add_long(uint16_t tag, uint32_t value)
+            {
+                add(tag, LONG, std::span<const uint32_t>(&value, 1));
+            }
+
+            void add_offsets(uint16_t tag, std::span<const uint64_t> values)
+            {
+                if (big_tiff_)
+                {
+                    add(tag, LONG8, values);
+                    return;
+                }
+
+                std::vector<uint32_t> values32(values.begin(), values.end());
+                add(tag, LONG, std::span<const uint32_t>(values32));
+            }
+
+            void add_string(uint16_t tag, std::string_view str)
+            {
+                std::string data(str);
+                data.push_back('\0');
+                entries_.push_back({tag, ASCII, data.size(), std::move(data)});
+            }
+
+            /**
+             * Returns the directory and its values, starting at
+             * @a offset in the file.
+             */
+            [[nodiscard]] std::string write(uint64_t offset)
+            {
+                std::ranges::sort(entries_, {}, &Entry::tag);
+
+                const size_t offset_size = big_tiff_ ? 8 : 4;
+                const size_t entry_size = big_tiff_ ? 20 : 12;
+                const size_t count_size = big_tiff_ ? 8 : 2;
+                auto value_offset = offset + count_size
+                                    + entries_.size() * entry_size
+                                    + offset_size;
+
+                std::string result;
+                std::string values;
+                write_offset(result, entries_.size(), count_size);
+                for (const auto& entry : entries_)
+                {
+                    append(result, entry.tag);
+                    append(result, entry.type);
+                    write_offset(result, entry.count, offset_size);
+                    if (entry.data.size() <= offset_size)
+                    {
+                        result.append(entry.data);
+                        result.append(offset_size - entry.data.size(), '\0');
+                        continue;
+                    }
+
+                    write_offset(result, value_offset + values.size(),
+                                 offset_size);
+                    values.append(entry.data);
+                    // Values must start on word boundaries.
+                    if (values.size() % 2 != 0)
+                        values.push_back('\0');
+                }
+                // There are no more directories.
+                write_offset(result, 0, offset_size);
+                return result + values;
+            }
+
+        private:
+            struct Entry
+            {
+                uint16_t tag;
+                uint16_t type;
+                uint64_t count;
+                std::string data;
+            };
+
+            static void write_offset(std::string& out, uint64_t value, size_t size)
+            {
+                if (size == 8)
+                    append(out, value);
+                else if (size == 4)
+                    append(out, uint32_t(value));
+                else
+                    append(out, uint16_t(value));
+            }
+
+            bool big_tiff_;
+            std::vector<Entry> entries_;
+        };
+
+        /**
+         * The GeoKeyDirectory and GeoAsciiParams tags. Keys must be
+         * added in increasing order.
+         */
+        class GeoKeyBuilder
+        {
+        public:
+            void add(uint16_t key, uint16_t value)
+            {
+                keys_.insert(keys_.end(), {key, 0, 1, value});
+            }
+
+            void add_string(uint16_t key, std::string_view str)
+            {
+                const auto offset = ascii_params_.size();
+                ascii_params_.append(str);
+                ascii_params_.push_back('|');
+                keys_.insert(keys_.end(), {
+                                 key, TiffTag::GEO_ASCII_PARAMS,
+                                 uint16_t(str.size() + 1), uint16_t(offset)
+                             });
+            }
+
+            void write(TiffDirectoryBuilder& directory) const
+            {
+                std::vector<uint16_t> keys = {
+                    1, 1, 0, uint16_t(keys_.size() / 4)
+                };
+                keys.insert(keys.end(), keys_.begin(), keys_.end());
+                directory.add(TiffTag::GEO_KEY_DIRECTORY, SHORT,
+                              std::span<const uint16_t>(keys));
+                if (!ascii_params_.empty())
+                    directory.add_string(TiffTag::GEO_ASCII_PARAMS, ascii_params_);
+            }
+
+        private:
+            std::vector<uint16_t> keys_;
+            std::string ascii_params_;
+        };
+
+        struct BlockLayout
+        {
+            size_t width = 0;
+            size_t height = 0;
+            size_t across = 0;
+            size_t down = 0;
+            bool tiled = false;
+        };
+
+        BlockLayout get_block_layout(const Size& size, size_t tile_size)
+        {
+            BlockLayout layout;
+            layout.tiled = tile_size != 0;
+            if (layout.tiled)
+            {
+                layout.width = tile_size;
+                layout.height = tile_size;
+            }
+            else
+            {
+                layout.width = size.columns;
+                layout.height = std::clamp<size_t>(STRIP_VALUES / size.columns,
+                                                   1, size.rows);
+            }
+            layout.across = (size.columns + layout.width - 1) / layout.width;
+            layout.down = (size.rows + layout.height - 1) / layout.height;
+            return layout;
+        }
+
+        /**
+         * Applies TIFF's floating point predictor to @a row and writes
+         * the result to @a dst. The bytes of the values are stored as
+         * planes, most significant byte first, and each byte is replaced
+         * by its difference from the previous byte.
+         */
+        void apply_floating_point_predictor(std::span<const float> row,
+                                            char* dst)
+        {
+            const auto n = row.size();
+            const auto src = reinterpret_cast<const char*>(row.data());
+            for (size_t i = 0; i < n; ++i)
+            {
+                for (size_t b = 0; b < sizeof(float); ++b)
+                {
+                    const auto src_byte = std::endian::native == std::endian::big
+                                              ? b
+                                              : sizeof(float) - 1 - b;
+                    dst[b * n + i] = src[i * sizeof(float) + src_byte];
+                }
+            }
+
+            for (size_t i = n * sizeof(float) - 1; i > 0; --i)
+                dst[i] = char(dst[i] - dst[i - 1]);
+        }
+
+        std::vector<char> deflate_block(const std::vector<char>& data,
+                                        int level)
+        {
+            auto size = compressBound(uLong(data.size()));
+            std::vector<char> result(size);
+            const auto status = compress2(
+                reinterpret_cast<Bytef*>(result.data()), &size,
+                reinterpret_cast<const Bytef*>(data.data()), uLong(data.size()),
+                level);
+            if (status != Z_OK)
+                GRIDLIB_THROW("Unable to compress data: error code "
+                              + std::to_string(status));
+            result.resize(size);
+            return result;
+        }
+
+        /**
+         * Returns the contents of tile or strip number @a index, ready
+         * to be written to the file.
+         */
+        std::vector<char> encode_block(Chorasmia::ArrayView2D<float> values,
+                                       const BlockLayout& layout,
+                                       size_t index,
+                                       const GeoTiffWriteOptions& options)
+        {
+            const auto row0 = (index / layout.across) * layout.height;
+            const auto col0 = (index % layout.across) * layout.width;
+            // Tiles are padded to their full size at the image's edges.
+            // The last strip only has the remaining rows.
+            const auto rows = layout.tiled
+                                  ? layout.height
+                                  : std::min(layout.height, values.row_count() - row0);
+            const auto row_size = layout.width * sizeof(float);
+
+            std::vector<char> block(rows * row_size);
+            std::vector<float> row(layout.width);
+            for (size_t r = 0; r < rows; ++r)
+            {
+                std::ranges::fill(row, UNKNOWN_ELEVATION);
+                if (row0 + r < values.row_count())
+                {
+                    const auto src = values.row(row0 + r);
+                    const auto n = std::min(layout.width, values.col_count() - col0);
+                    std::copy_n(src.begin() + col0, n, row.begin());
+                }
+
+                const auto dst = block.data() + r * row_size;
+                if (options.predictor)
+                    apply_floating_point_predictor(row, dst);
+                else
+                    std::memcpy(dst, row.data(), row_size);
+            }
+
+            if (options.compression == GeoTiffCompression::DEFLATE)
+                return deflate_block(block, options.compression_level);
+            return block;
+        }
+
+        std::string_view find_information(const SpatialInfo& model,
+                                          std::string_view key)
+        {
+            for (const auto& [k, v] : model.information)
+            {
+                if (k == key)
+                    return v;
+            }
+            return {};
+        }
+
+        /**
+         * Removes the scale and offset items from GDAL's XML metadata.
+         * The grid's elevations have already been scaled.
+         */
+        std::string remove_scale_and_offset(std::string_view xml)
+        {
+            std::string result;
+            size_t pos = 0;
+            while (true)
+            {
+                const auto start = xml.find("<Item", pos);
+                const auto end = xml.find("</Item>", start);
+                if (start == std::string_view::npos || end == std::string_view::npos)
+                    break;
+
+                const auto item_end = end + 7;
+                const auto item = xml.substr(start, item_end - start);
+                result.append(xml.substr(pos, start - pos));
+                if (item.find("role=\"scale\"") == std::string_view::npos
+                    && item.find("role=\"offset\"") == std::string_view::npos)
+                {
+                    result.append(item);
+                }
+                pos = item_end;
+            }
+            result.append(xml.substr(pos));
+            return result;
+        }
+
+        bool is_north_up(const SpatialInfo& model)
+        {
+            const auto row_axis = model.row_axis();
+            const auto column_axis = model.column_axis();
+            const auto vertical_axis = model.vertical_axis();
+            return row_axis[0] > 0 && row_axis[1] == 0 && row_axis[2] == 0
+                   && column_axis[0] == 0 && column_axis[1] < 0
+                   && column_axis[2] == 0
+                   && vertical_axis[0] == 0 && vertical_axis[1] == 0
+                   && vertical_axis[2] != 0;
+        }
+
+        void add_model_tags(TiffDirectoryBuilder& directory, const IGrid& grid)
+        {
+            const auto& model = grid.spatial_info();
+            const auto tie_point = grid.tie_point();
+            const auto location = model.location();
+            if (is_north_up(model))
+            {
+                const double scale[] = {
+                    model.row_axis()[0],
+                    -model.column_axis()[1],
+                    model.vertical_axis()[2]
+                };
+                directory.add(TiffTag::MODEL_PIXEL_SCALE, DOUBLE,
+                              std::span<const double>(scale));
+                // GeoTIFF's raster coordinates are (column, row).
+                const double tie[] = {
+                    tie_point[1], tie_point[0], 0.0,
+                    location[0], location[1], location[2]
+                };
+                directory.add(TiffTag::MODEL_TIE_POINT, DOUBLE,
+                              std::span<const double>(tie));
+                return;
+            }
+
+            const auto r = model.row_axis();
+            const auto c = model.column_axis();
+            const auto v = model.vertical_axis();
+            const auto t = location - tie_point[0] * c - tie_point[1] * r;
+            const double matrix[] = {
+                r[0], c[0], v[0], t[0],
+                r[1], c[1], v[1], t[1],
+                r[2], c[2], v[2], t[2],
+                0.0, 0.0, 0.0, 1.0
+            };
+            directory.add(TiffTag::MODEL_TRANSFORMATION, DOUBLE,
+                          std::span<const double>(matrix));
+        }
+
+        /**
+         * Adds @a code as @a key and @a citation as @a citation_key.
+         * Geo keys are 16-bit, larger codes are written as user-defined
+         * and appended to the citation.
+         */
+        void add_crs_code(GeoKeyBuilder& keys,
+                          uint16_t key, uint16_t citation_key,
+                          int code, std::string citation)
+        {
+            if (code > 0 && code <= std::numeric_limits<uint16_t>::max())
+            {
+                keys.add(key, uint16_t(code));
+            }
+            else if (code != 0)
+            {
+                keys.add(key, USER_DEFINED_CODE);
+                if (!citation.empty())
+                    citation.push_back(' ');
+                citation += "(EPSG:" + std::to_string(code) + ")";
+            }
+
+            if (!citation.empty())
+                keys.add_string(citation_key, citation);
+        }
+
+        void add_geo_keys(TiffDirectoryBuilder& directory, const SpatialInfo& model)
+        {
+            const auto& crs = model.crs;
+            const auto horizontal_unit = uint16_t(unit_to_epsg_unit(model.horizontal_unit));
+            const auto vertical_unit = uint16_t(unit_to_epsg_unit(model.vertical_unit));
+            const auto citation = find_information(model, "citation");
+
+            GeoKeyBuilder keys;
+            if (crs.type == CrsType::PROJECTED)
+                keys.add(GeoKey::MODEL_TYPE, MODEL_TYPE_PROJECTED);
+            else if (crs.type == CrsType::GEOGRAPHIC)
+                keys.add(GeoKey::MODEL_TYPE, MODEL_TYPE_GEOGRAPHIC);
+            keys.add(GeoKey::RASTER_TYPE, RASTER_PIXEL_IS_AREA);
+            if (!citation.empty())
+                keys.add_string(GeoKey::CITATION, citation);
+
+            if (crs.type == CrsType::GEOGRAPHIC)
+            {
+                add_crs_code(keys, GeoKey::GEODETIC_CRS, GeoKey::GEOG_CITATION,
+                             crs.code, crs.citation);
+                if (horizontal_unit != 0)
+                    keys.add(GeoKey::GEOG_ANGULAR_UNITS, horizontal_unit);
+            }
+            else if (crs.type == CrsType::PROJECTED)
+            {
+                add_crs_code(keys, GeoKey::PROJECTED_CRS, GeoKey::PROJECTED_CITATION,
+                             crs.code, crs.citation);
+                if (horizontal_unit != 0)
+                    keys.add(GeoKey::PROJECTED_LINEAR_UNITS, horizontal_unit);
+            }
+
+            add_crs_code(keys, GeoKey::VERTICAL_CRS, GeoKey::VERTICAL_CITATION,
+                         crs.vertical_code, {});
+            if (vertical_unit != 0)
+                keys.add(GeoKey::VERTICAL_UNITS, vertical_unit);
+
+            keys.write(directory);
+        }
+
+        void add_information_tags(TiffDirectoryBuilder& directory,
+                                  const SpatialInfo& model)
+        {
+            const std::pair<uint16_t, std::string_view> tags[] = {
+                {TiffTag::SOFTWARE, "software"},
+                {TiffTag::DATE_TIME, "date"},
+                {TiffTag::ARTIST, "artist"},
+                {TiffTag::HOST_COMPUTER, "host_computer"}
+            };
+            for (const auto& [tag, key] : tags)
+            {
+                if (const auto value = find_information(model, key); !value.empty())
+                    directory.add_string(tag, value);
+            }
+
+            if (const auto gdal = find_information(model, "gdal"); !gdal.empty())
+                directory.add_string(TiffTag::GDAL_METADATA, remove_scale_and_offset(gdal));
+        }
+
+        void write_header(std::ostream& stream, bool big_tiff, uint64_t ifd_offset)
+        {
+            std::string header = std::endian::native == std::endian::big ? "MM" : "II";
+            if (big_tiff)
+            {
+                append(header, uint16_t(43));
+                append(header, uint16_t(8));
+                append(header, uint16_t(0));
+                append(header, ifd_offset);
+            }
+            else
+            {
+                append(header, uint16_t(42));
+                append(header, uint32_t(ifd_offset));
+            }
+            stream.write(header.data(), std::streamsize(header.size()));
+        }
+    }
+
+    void write_geotiff(const std::filesystem::path& path,
+                       const IGrid& grid,
+                       const GeoTiffWriteOptions& options)
+    {
+        const auto values = grid.values();
+        if (values.empty())
+            GRIDLIB_THROW("Can not write an empty grid as GeoTIFF.");
+        if (options.tile_size % 16 != 0)
+            GRIDLIB_THROW("The tile size must be a multiple of 16.");
+
+        const auto layout = get_block_layout(values.dimensions(), options.tile_size);
+        const auto block_count = layout.across * layout.down;
+
+        // Use BigTIFF if the file might need offsets beyond 32 bits.
+        const auto block_size = uLong(layout.width * layout.height * sizeof(float));
+        const auto max_block_size = options.compression == GeoTiffCompression::DEFLATE
+                                        ? compressBound(block_size)
+                                        : block_size;
+        uint64_t max_metadata_size = 0x10000 + block_count * 16;
+        for (const auto& [key, value] : grid.spatial_info().information)
+            max_metadata_size += value.size() + 2;
+        const bool big_tiff = block_count * uint64_t(max_block_size) + max_metadata_size
+                              > std::numeric_limits<uint32_t>::max();
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+            GRIDLIB_THROW("Can not create file: " + path.string());
+        write_header(file, big_tiff, 0);
+        uint64_t pos = big_tiff ? 16 : 8;
+
+        const auto thread_count = options.thread_count != 0
+                                      ? options.thread_count
+                                      : std::max(std::thread::hardware_concurrency(), 1u);
+        const auto policy = thread_count > 1 ? std::launch::async
+                                             : std::launch::deferred;
+
+        std::vector<uint64_t> offsets;
+        std::vector<uint64_t> sizes;
+        offsets.reserve(block_count);
+        sizes.reserve(block_count);
+        std::deque<std::future<std::vector<char>>> pending;
+        size_t next = 0;
+        for (size_t i = 0; i < block_count; ++i)
+        {
+            while (next < block_count && pending.size() < thread_count)
+            {
+                pending.push_back(std::async(policy, encode_block, values,
+                                             std::cref(layout), next,
+                                             std::cref(options)));
+                ++next;
+            }
+
+            const auto block = pending.front().get();
+            pending.pop_front();
+            file.write(block.data(), std::streamsize(block.size()));
+            offsets.push_back(pos);
+            sizes.push_back(block.size());
+            pos += block.size();
+        }
+
+        // The directory must start on a word boundary.
+        if (pos % 2 != 0)
+        {
+            file.put('\0');
+            ++pos;
+        }
+
+        TiffDirectoryBuilder directory(big_tiff);
+        const auto size = values.dimensions();
+        directory.add_long(TiffTag::IMAGE_WIDTH, uint32_t(size.columns));
+        directory.add_long(TiffTag::IMAGE_LENGTH, uint32_t(size.rows));
+        directory.add_short(TiffTag::BITS_PER_SAMPLE, 32);
+        directory.add_short(TiffTag::COMPRESSION,
+                            options.compression == GeoTiffCompression::DEFLATE
+                                ? COMPRESSION_DEFLATE
+                                : COMPRESSION_NONE);
+        directory.add_short(TiffTag::PHOTOMETRIC, PHOTOMETRIC_MIN_IS_BLACK);
+        directory.add_short(TiffTag::SAMPLES_PER_PIXEL, 1);
+        directory.add_short(TiffTag::PLANAR_CONFIGURATION, 1);
+        directory.add_short(TiffTag::SAMPLE_FORMAT, SAMPLE_FORMAT_IEEEFP);
+        if (options.predictor)
+            directory.add_short(TiffTag::PREDICTOR, PREDICTOR_FLOATING_POINT);
+        if (layout.tiled)
+        {
+            directory.add_long(TiffTag::TILE_WIDTH, uint32_t(layout.width));
+            directory.add_long(TiffTag::TILE_LENGTH, uint32_t(layout.height));
+            directory.add_offsets(TiffTag::TILE_OFFSETS, offsets);
+            directory.add_offsets(TiffTag::TILE_BYTE_COUNTS, sizes);
+        }
+        else
+        {
+            directory.add_long(TiffTag::ROWS_PER_STRIP, uint32_t(layout.height));
+            directory.add_offsets(TiffTag::STRIP_OFFSETS, offsets);
+            directory.add_offsets(TiffTag::STRIP_BYTE_COUNTS, sizes);
+        }
+
+        const auto& model = grid.spatial_info();
+        add_model_tags(directory, grid);
+        add_geo_keys(directory, model);
+        add_information_tags(directory, model);
+        directory.add_string(TiffTag::GDAL_NODATA,
+                             std::to_string(int64_t(UNKNOWN_ELEVATION)));
+
+        const auto ifd = directory.write(pos);
+        file.write(ifd.data(), std::streamsize(ifd.size()));
+        file.seekp(0);
+        write_header(file, big_tiff, pos);
+        if (!file)
+            GRIDLIB_THROW("Error while writing file: " + path.string());
+    }
+}
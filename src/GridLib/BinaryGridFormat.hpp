@@ -0,0 +1,34 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "Utilities/ByteOrder.hpp"
+
+// The layout of GridLib's binary grid files. All numbers are stored in
+// little-endian byte order.
+//
+// Offset  Size  Contents
+//      0     8  BINARY_GRID_MAGIC
+//      8     4  Format version
+//     12     4  Payload offset, a multiple of BINARY_GRID_ALIGNMENT
+//     16     8  Row count
+//     24     8  Column count
+//     32     4  Size of the model
+//     36     4  Reserved, 0
+//     40     -  The spatial information ("model") as compact JSON
+//              followed by zero padding up to the payload offset
+//      -     -  The elevations as row-major float32 values
+
+namespace GridLib
+{
+    constexpr std::string_view BINARY_GRID_MAGIC = {"GridLib\x1A", 8};
+    constexpr uint32_t BINARY_GRID_VERSION = 1;
+    constexpr size_t BINARY_GRID_FIXED_HEADER_SIZE = 40;
+    constexpr size_t BINARY_GRID_ALIGNMENT = 64;
+}
@@ -0,0 +1,163 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GridIndex.hpp"
+
+#include <algorithm>
+
+namespace GridLib
+{
+    namespace
+    {
+        int64_t floor_div(int64_t a, int64_t b)
+        {
+            const auto q = a / b;
+            return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+        }
+
+        bool is_empty(const SignedExtent& extent)
+        {
+            return extent.size.rows <= 0 || extent.size.columns <= 0;
+        }
+    }
+
+    void GridIndex::insert(const SignedExtent& extent)
+    {
+        const auto id = extents_.size();
+        extents_.push_back(extent);
+        if (is_empty(extent))
+            return;
+
+        if (buckets_.empty())
+        {
+            bucket_size_ = extent.size;
+        }
+        else if (extent.size.rows > MAX_BUCKETS_PER_SIDE * bucket_size_.rows
+                 || extent.size.columns > MAX_BUCKETS_PER_SIDE * bucket_size_.columns)
+        {
+            rebuild(extent.size);
+            return;
+        }
+
+        add_to_buckets(id);
+    }
+
+    void GridIndex::add_to_buckets(size_t id)
+    {
+        const auto [min, max] = get_bucket_range(extents_[id]);
+        for (auto i = min.first; i <= max.first; ++i)
+        {
+            for (auto j = min.second; j <= max.second; ++j)
+                buckets_[{i, j}].push_back(id);
+        }
+    }
+
+    void GridIndex::rebuild(const Chorasmia::Size2D<int64_t>& min_bucket_size)
+    {
+        // Use the largest extent's size, every extent then covers at most
+        // four buckets. The bucket size at least quadruples in one of the
+        // dimensions on each rebuild, which keeps rebuilds rare.
+        bucket_size_ = {
+            std::max(bucket_size_.rows, min_bucket_size.rows),
+            std::max(bucket_size_.columns, min_bucket_size.columns)
+        };
+        buckets_.clear();
+        for (size_t id = 0; id < extents_.size(); ++id)
+        {
+            if (!is_empty(extents_[id]))
+                add_to_buckets(id);
+        }
+    }
+
+    size_t GridIndex::size() const
+    {
+        return extents_.size();
+    }
+
+    bool GridIndex::intersects(const SignedExtent& extent) const
+    {
+        return visit_buckets(extent, [&](const std::vector<size_t>& ids)
+        {
+            return std::ranges::any_of(ids, [&](size_t id)
+            {
+                return bool(get_intersection(extent, extents_[id]));
+            });
+        });
+    }
+
+    void GridIndex::find(const SignedExtent& extent,
+                         std::vector<size_t>& ids) const
+    {
+        ids.clear();
+        visit_buckets(extent, [&](const std::vector<size_t>& bucket)
+        {
+            for (const auto id : bucket)
+            {
+                if (get_intersection(extent, extents_[id]))
+                    ids.push_back(id);
+            }
+            return false;
+        });
+
+        // Extents that span several buckets are found more than once.
+        std::ranges::sort(ids);
+        const auto [first, last] = std::ranges::unique(ids);
+        ids.erase(first, last);
+    }
+
+    std::pair<GridIndex::BucketKey, GridIndex::BucketKey>
+    GridIndex::get_bucket_range(const SignedExtent& extent) const
+    {
+        const auto [row, col] = extent.origin;
+        const auto [rows, cols] = extent.size;
+        return {
+            {floor_div(row, bucket_size_.rows),
+             floor_div(col, bucket_size_.columns)},
+            {floor_div(row + rows - 1, bucket_size_.rows),
+             floor_div(col + cols - 1, bucket_size_.columns)}
+        };
+    }
+
+    template <typename Func>
+    bool GridIndex::visit_buckets(const SignedExtent& extent, Func func) const
+    {
+        if (is_empty(extent) || buckets_.empty())
+            return false;
+
+        const auto [min, max] = get_bucket_range(extent);
+        const auto rows = uint64_t(max.first - min.first) + 1;
+        const auto cols = uint64_t(max.second - min.second) + 1;
+
+        // Large extents cover more buckets than there are buckets with
+        // content, it is then cheaper to visit all the non-empty buckets.
+        if (rows > buckets_.size() || cols > buckets_.size()
+            || rows * cols > buckets_.size())
+        {
+            for (const auto& [key, ids] : buckets_)
+            {
+                if (min.first <= key.first && key.first <= max.first
+                    && min.second <= key.second && key.second <= max.second
+                    && func(ids))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        for (auto i = min.first; i <= max.first; ++i)
+        {
+            for (auto j = min.second; j <= max.second; ++j)
+            {
+                const auto it = buckets_.find({i, j});
+                if (it != buckets_.end() && func(it->second))
+                    return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,75 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include "GridLib/MultiGridReader.hpp"
+
+namespace GridLib
+{
+    /**
+     * @brief A spatial index over the extents of the grids in a
+     *  MultiGridReader.
+     *
+     * The extents are sorted into a uniform grid of buckets, the bucket
+     * size is initially the size of the first extent that is inserted.
+     * The index is rebuilt with larger buckets when an extent spans more
+     * than MAX_BUCKETS_PER_SIDE buckets in either direction. Lookups only
+     * visit the buckets that overlap the requested extent.
+     */
+    class GridIndex
+    {
+    public:
+        /**
+         * @brief Adds @a extent to the index. The extent's id is its
+         *  position in the insertion order.
+         */
+        void insert(const SignedExtent& extent);
+
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * @brief Returns true if any of the indexed extents intersects
+         *  @a extent.
+         */
+        [[nodiscard]] bool intersects(const SignedExtent& extent) const;
+
+        /**
+         * @brief Assigns the ids of the extents that intersect @a extent
+         *  to @a ids, in insertion order.
+         */
+        void find(const SignedExtent& extent, std::vector<size_t>& ids) const;
+    private:
+        static constexpr int64_t MAX_BUCKETS_PER_SIDE = 4;
+
+        using BucketKey = std::pair<int64_t, int64_t>;
+
+        struct BucketKeyHash
+        {
+            size_t operator()(const BucketKey& key) const
+            {
+                const auto h = std::hash<int64_t>();
+                return h(key.first) * 31 + h(key.second);
+            }
+        };
+
+        void add_to_buckets(size_t id);
+
+        void rebuild(const Chorasmia::Size2D<int64_t>& min_bucket_size);
+
+        [[nodiscard]] std::pair<BucketKey, BucketKey>
+        get_bucket_range(const SignedExtent& extent) const;
+
+        template <typename Func>
+        bool visit_buckets(const SignedExtent& extent, Func func) const;
+
+        Chorasmia::Size2D<int64_t> bucket_size_ = {1, 1};
+        std::vector<SignedExtent> extents_;
+        std::unordered_map<BucketKey, std::vector<size_t>, BucketKeyHash> buckets_;
+    };
+}
@@ -7,17 +7,195 @@
 //****************************************************************************
 #include "GridLib/MultiGridReader.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <thread>
 #include <Chorasmia/ArrayView2DAlgorithms.hpp>
 
 #include "GridLib/GridLibException.hpp"
 #include "GridLib/PositionTransformer.hpp"
 #include "GridLib/ReadGrid.hpp"
+#include "GridIndex.hpp"
+#include "TileCache.hpp"
+#include "Utilities/FloatCompression.hpp"
+#include "Utilities/MemoryMappedFile.hpp"
+#include "Utilities/PositionalFileReader.hpp"
 #include "Utilities/TemporaryFile.hpp"
+#include "GridLibVersion.hpp"
+
+#ifdef GridLib_DEM_SUPPORT
+#include "GridLib/ReadDem.hpp"
+#endif
 
 namespace GridLib
 {
     namespace
     {
+        constexpr size_t DEFAULT_CACHE_CAPACITY = 256 * 1024 * 1024;
+        constexpr size_t COMPRESSED_BLOCK_SIZE = 256;
+
+        Size get_block_count(const Size& size)
+        {
+            return {(size.rows + COMPRESSED_BLOCK_SIZE - 1) / COMPRESSED_BLOCK_SIZE,
+                    (size.columns + COMPRESSED_BLOCK_SIZE - 1) / COMPRESSED_BLOCK_SIZE};
+        }
+
+        Extent get_block_extent(size_t block_row, size_t block_col,
+                                const Size& grid_size)
+        {
+            const Extent extent{{block_row * COMPRESSED_BLOCK_SIZE,
+                                 block_col * COMPRESSED_BLOCK_SIZE},
+                                {COMPRESSED_BLOCK_SIZE, COMPRESSED_BLOCK_SIZE}};
+            return clamp(extent, grid_size);
+        }
+
+        /**
+         * Compresses @a values in blocks of COMPRESSED_BLOCK_SIZE x
+         * COMPRESSED_BLOCK_SIZE values and appends them to @a output.
+         * Returns the offsets of the blocks in @a output, followed by
+         * the size of @a output.
+         */
+        std::vector<uint64_t>
+        compress_blocks(Chorasmia::ArrayView2D<float> values,
+                        std::vector<char>& output)
+        {
+            const auto size = values.dimensions();
+            const auto [block_rows, block_cols] = get_block_count(size);
+            std::vector<uint64_t> offsets;
+            std::vector<float> block;
+            for (size_t i = 0; i < block_rows; ++i)
+            {
+                for (size_t j = 0; j < block_cols; ++j)
+                {
+                    const auto extent = get_block_extent(i, j, size);
+                    block.resize(get_array_size(extent.size));
+                    Chorasmia::copy(values.subarray(extent),
+                                    Chorasmia::MutableArrayView2D(block.data(), extent.size),
+                                    Chorasmia::Index2DMode::ROWS);
+                    offsets.push_back(output.size());
+                    compress_floats(block, output);
+                }
+            }
+            offsets.push_back(output.size());
+            return offsets;
+        }
+
+        GridLibException make_file_exception(const std::filesystem::path& filename)
+        {
+            return GRIDLIB_EXCEPTION("Error reading grid from file: "
+                                     + filename.string());
+        }
+
+        /**
+         * Reads @a filename without starting any threads of its own, for
+         * use when several files are decoded in parallel.
+         */
+        Grid read_grid_single_threaded(const std::filesystem::path& filename)
+        {
+#ifdef GridLib_DEM_SUPPORT
+            if (is_dem(filename))
+                return read_dem(filename, 1);
+#endif
+            return read_grid(filename, GridFileType::AUTO_DETECT);
+        }
+
+        /**
+         * Decodes the files in @a filenames in parallel with @a decode and
+         * passes the results to @a add in the order of the files. No more
+         * than @a thread_count files are decoded at the same time.
+         */
+        template <typename DecodeFunc, typename AddFunc>
+        void decode_in_parallel(std::span<const std::filesystem::path> filenames,
+                                size_t thread_count,
+                                DecodeFunc decode,
+                                AddFunc add)
+        {
+            using Result = std::invoke_result_t<DecodeFunc, const std::filesystem::path&>;
+            std::deque<std::future<Result>> pending;
+            size_t next = 0;
+            for (const auto& filename : filenames)
+            {
+                while (next < filenames.size() && pending.size() < thread_count)
+                {
+                    pending.push_back(std::async(std::launch::async, decode,
+                                                 std::cref(filenames[next])));
+                    ++next;
+                }
+
+                try
+                {
+                    add(pending.front().get(), filename);
+                }
+                catch (const std::exception&)
+                {
+                    std::throw_with_nested(make_file_exception(filename));
+                }
+                pending.pop_front();
+            }
+        }
+
+        /**
+         * Merges @a src into @a dst according to @a policy. @a counts is
+         * only used by MultiGridMergePolicy::MEAN, it holds the number of
+         * values that have been summed in each cell of @a dst.
+         */
+        void merge_values(Chorasmia::ArrayView2D<float> src,
+                          Chorasmia::MutableArrayView2D<float> dst,
+                          Chorasmia::MutableArrayView2D<uint32_t> counts,
+                          MultiGridMergePolicy policy)
+        {
+            for (size_t i = 0; i < src.row_count(); ++i)
+            {
+                const auto src_row = src.row(i);
+                auto dst_it = dst.row(i).begin();
+                switch (policy)
+                {
+                case MultiGridMergePolicy::LAST_WINS:
+                    for (const auto value : src_row)
+                    {
+                        if (value != UNKNOWN_ELEVATION)
+                            *dst_it = value;
+                        ++dst_it;
+                    }
+                    break;
+                case MultiGridMergePolicy::FIRST_WINS:
+                    for (const auto value : src_row)
+                    {
+                        if (*dst_it == UNKNOWN_ELEVATION)
+                            *dst_it = value;
+                        ++dst_it;
+                    }
+                    break;
+                case MultiGridMergePolicy::MEAN:
+                {
+                    auto count_it = counts.row(i).begin();
+                    for (const auto value : src_row)
+                    {
+                        if (value != UNKNOWN_ELEVATION)
+                        {
+                            *dst_it = *count_it == 0 ? value : *dst_it + value;
+                            ++*count_it;
+                        }
+                        ++dst_it;
+                        ++count_it;
+                    }
+                    break;
+                }
+                case MultiGridMergePolicy::MAX:
+                    for (const auto value : src_row)
+                    {
+                        // UNKNOWN_ELEVATION is smaller than any real
+                        // elevation.
+                        if (value > *dst_it)
+                            *dst_it = value;
+                        ++dst_it;
+                    }
+                    break;
+                }
+            }
+        }
+
         template <std::floating_point T>
         T get_fraction(T value)
         {
@@ -50,23 +228,70 @@ namespace GridLib
     struct GridData
     {
         std::filesystem::path filename;
+        // The grid is decoded from filename rather than read from the
+        // temporary file.
+        bool on_demand = false;
         std::streampos temp_file_offset = 0;
         SignedExtent extent;
         Xyz::Vector2D tie_point;
         SpatialInfo spatial_info;
         size_t z = 0;
+        // The offsets of the grid's compressed blocks in the temporary
+        // file, followed by the offset of the end of the last block.
+        // Only used with MultiGridStorage::COMPRESSED_FILE.
+        std::vector<uint64_t> block_offsets;
+        // The cache key of the grid's first block.
+        size_t first_block_key = 0;
+    };
+
+    struct MultiGridReader::MergeTarget
+    {
+        Chorasmia::MutableArrayView2D<float> values;
+        Chorasmia::MutableArrayView2D<uint32_t> counts;
+        MultiGridMergePolicy policy = MultiGridMergePolicy::LAST_WINS;
+        /**
+         * True if only one grid intersects the extent, its values can
+         * then be copied as they are.
+         */
+        bool single_grid = false;
+
+        void merge(Chorasmia::ArrayView2D<float> src,
+                   const Chorasmia::Extent2D<size_t>& dst_extent) const
+        {
+            const auto dst = values.subarray(dst_extent);
+            if (single_grid)
+                Chorasmia::copy(src, dst, Chorasmia::Index2DMode::ROWS);
+            else if (policy == MultiGridMergePolicy::MEAN)
+                merge_values(src, dst, counts.subarray(dst_extent), policy);
+            else
+                merge_values(src, dst, {}, policy);
+        }
     };
 
     struct MultiGridReader::Data
     {
+        explicit Data(MultiGridStorage storage)
+            : storage(storage),
+              cache(DEFAULT_CACHE_CAPACITY)
+        {}
+
+        MultiGridStorage storage;
         std::vector<GridData> grids;
+        GridIndex index;
         TemporaryFile temp_file;
+        // Must be declared after temp_file as the file can't be removed
+        // while it is open or mapped on some platforms.
+        PositionalFileReader file_reader;
+        MemoryMappedFile mapped_file;
         SignedExtent extent;
-        std::vector<float> buffer;
+        TileCache cache;
+        MultiGridMergePolicy merge_policy = MultiGridMergePolicy::LAST_WINS;
+        uint64_t temp_file_size = 0;
+        size_t block_count = 0;
     };
 
-    MultiGridReader::MultiGridReader()
-        : data_(std::make_unique<Data>())
+    MultiGridReader::MultiGridReader(MultiGridStorage storage)
+        : data_(std::make_unique<Data>(storage))
     {
     }
 
@@ -86,22 +311,71 @@ namespace GridLib
         return *this;
     }
 
+    MultiGridStorage MultiGridReader::storage() const
+    {
+        assert_data();
+        return data_->storage;
+    }
+
     Size MultiGridReader::size() const
     {
         return cast<size_t>(data_->extent.size);
     }
 
+    uint64_t MultiGridReader::storage_size() const
+    {
+        assert_data();
+        return data_->temp_file_size;
+    }
+
+    size_t MultiGridReader::cache_capacity() const
+    {
+        assert_data();
+        return data_->cache.capacity();
+    }
+
+    void MultiGridReader::set_cache_capacity(size_t capacity)
+    {
+        assert_data();
+        data_->cache.set_capacity(capacity);
+    }
+
+    MultiGridCacheStatistics MultiGridReader::cache_statistics() const
+    {
+        assert_data();
+        return data_->cache.statistics();
+    }
+
+    MultiGridMergePolicy MultiGridReader::merge_policy() const
+    {
+        assert_data();
+        return data_->merge_policy;
+    }
+
+    void MultiGridReader::set_merge_policy(MultiGridMergePolicy policy)
+    {
+        assert_data();
+        data_->merge_policy = policy;
+    }
+
     void MultiGridReader::read_grid(const std::filesystem::path& filename)
     {
         assert_data();
         try
         {
-            add_grid(GridLib::read_grid(filename, GridFileType::AUTO_DETECT), filename);
+            if (data_->storage != MultiGridStorage::SOURCE_FILES)
+            {
+                add_grid(GridLib::read_grid(filename, GridFileType::AUTO_DETECT),
+                         filename);
+                return;
+            }
+
+            add_grid_info(read_grid_info(filename, GridFileType::AUTO_DETECT),
+                          filename);
         }
         catch (const std::exception&)
         {
-            std::throw_with_nested(GRIDLIB_EXCEPTION("Error reading grid from file: "
-                + filename.string()));
+            std::throw_with_nested(make_file_exception(filename));
         }
     }
 
@@ -118,42 +392,98 @@ namespace GridLib
         }
     }
 
+    void MultiGridReader::read_grids(std::span<const std::filesystem::path> filenames,
+                                     unsigned thread_count)
+    {
+        assert_data();
+        if (thread_count == 0)
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+        if (data_->storage == MultiGridStorage::SOURCE_FILES)
+        {
+            decode_in_parallel(
+                filenames, thread_count,
+                [](const std::filesystem::path& filename)
+                {
+                    return read_grid_info(filename, GridFileType::AUTO_DETECT);
+                },
+                [this](GridInfo info, const std::filesystem::path& filename)
+                {
+                    add_grid_info(std::move(info), filename);
+                });
+        }
+        else
+        {
+            decode_in_parallel(
+                filenames, thread_count,
+                [thread_count](const std::filesystem::path& filename)
+                {
+                    if (thread_count > 1)
+                        return read_grid_single_threaded(filename);
+                    return GridLib::read_grid(filename, GridFileType::AUTO_DETECT);
+                },
+                [this](const Grid& grid, const std::filesystem::path& filename)
+                {
+                    add_grid(grid, filename);
+                });
+        }
+    }
+
     void MultiGridReader::add_grid(const Grid& grid,
                                    const std::filesystem::path& filename)
     {
         if (grid.values().empty())
             return;
 
-        assert_compatible_grid(grid);
+        assert_compatible_grid(grid.spatial_info());
+        const auto origin = get_insertion_point(grid.spatial_info());
 
-        auto& stream = data_->temp_file.stream();
-        const auto temp_file_pos = stream.tellp();
-        auto [rows, cols] = grid.size();
-        stream.write(reinterpret_cast<const char*>(grid.values().data()),
-                     std::streamsize(rows * cols * sizeof(float)));
-        SignedIndex origin;
-        if (!data_->grids.empty())
-        {
-            const auto& first = data_->grids.front();
-            origin = get_insertion_point(
-                grid.spatial_info(),
-                PositionTransformer(
-                    first.spatial_info.matrix,
-                    first.tie_point));
-        }
-        data_->grids.push_back({
+        GridData grid_data{
             filename,
-            temp_file_pos,
+            false,
+            std::streampos(std::streamoff(data_->temp_file_size)),
             {origin, cast<int64_t>(grid.size())},
             grid.tie_point(),
-            grid.spatial_info(),
-            data_->grids.size()
-        });
+            grid.spatial_info()
+        };
 
-        const auto min = get_min(data_->extent.min_index(), origin);
-        const auto max = get_max(data_->extent.max_index(),
-                                 origin + cast<int64_t>(grid.size()));
-        data_->extent = {min, max - min};
+        auto& stream = data_->temp_file.stream();
+        if (data_->storage == MultiGridStorage::COMPRESSED_FILE)
+        {
+            std::vector<char> buffer;
+            grid_data.block_offsets = compress_blocks(grid.values(), buffer);
+            for (auto& offset : grid_data.block_offsets)
+                offset += data_->temp_file_size;
+            grid_data.first_block_key = data_->block_count;
+            data_->block_count += grid_data.block_offsets.size() - 1;
+            stream.write(buffer.data(), std::streamsize(buffer.size()));
+            data_->temp_file_size += buffer.size();
+        }
+        else
+        {
+            const auto size = get_array_size(grid.size()) * sizeof(float);
+            stream.write(reinterpret_cast<const char*>(grid.values().data()),
+                         std::streamsize(size));
+            data_->temp_file_size += size;
+        }
+
+        stream.flush();
+        if (!stream)
+            GRIDLIB_THROW("Unable to write grid to temporary file.");
+
+        if (data_->storage == MultiGridStorage::MEMORY_MAPPED_FILE)
+        {
+            // The file has grown, the mapping must be renewed to include
+            // the new grid.
+            data_->mapped_file.close();
+            data_->mapped_file = MemoryMappedFile(data_->temp_file.path());
+        }
+        else if (!data_->file_reader.is_open())
+        {
+            data_->file_reader = PositionalFileReader(data_->temp_file.path());
+        }
+
+        add_grid_data(std::move(grid_data));
     }
 
     bool MultiGridReader::has_data(Extent extent) const
@@ -162,45 +492,139 @@ namespace GridLib
         extent = clamp(extent, cast<size_t>(data_->extent.size));
         auto internal_extent = cast<int64_t>(extent);
         internal_extent.origin += data_->extent.origin;
+        return data_->index.intersects(internal_extent);
+    }
+
+    Grid MultiGridReader::get_grid(Extent extent) const
+    {
+        Grid result;
+        get_grid_into(extent, result);
+        return result;
+    }
+
+    std::vector<Extent>
+    MultiGridReader::get_tiles_with_data(const Size& tile_size) const
+    {
+        assert_data();
+        if (tile_size.rows == 0 || tile_size.columns == 0)
+            GRIDLIB_THROW("Tile size can not be zero.");
+
+        std::vector<std::pair<size_t, size_t>> tiles;
         for (const auto& grid_data : data_->grids)
         {
-            if (get_intersection(internal_extent, grid_data.extent))
-                return true;
+            const auto [row, col] = cast<size_t>(grid_data.extent.origin
+                                                  - data_->extent.origin);
+            const auto [rows, cols] = cast<size_t>(grid_data.extent.size);
+            for (auto i = row / tile_size.rows; i <= (row + rows - 1) / tile_size.rows; ++i)
+            {
+                for (auto j = col / tile_size.columns; j <= (col + cols - 1) / tile_size.columns; ++j)
+                    tiles.emplace_back(i, j);
+            }
+        }
+
+        std::ranges::sort(tiles);
+        const auto [first, last] = std::ranges::unique(tiles);
+        tiles.erase(first, last);
+
+        const auto size = this->size();
+        std::vector<Extent> result;
+        result.reserve(tiles.size());
+        for (const auto& [i, j] : tiles)
+        {
+            const Extent extent({i * tile_size.rows, j * tile_size.columns}, tile_size);
+            result.push_back(clamp(extent, size));
         }
-        return false;
+        return result;
     }
 
-    Grid MultiGridReader::get_grid(Extent extent) const
+    void MultiGridReader::get_grid_into(Extent extent, Grid& result) const
+    {
+        assert_data();
+        const auto internal_extent = get_internal_extent(extent);
+        result.resize(cast<size_t>(internal_extent.size));
+        assign_spatial_info(internal_extent, result.spatial_info());
+        copy_values(internal_extent, result.values());
+    }
+
+    void MultiGridReader::get_grid_into(Extent extent,
+                                        Chorasmia::MutableArrayView2D<float> values) const
     {
         assert_data();
+        const auto internal_extent = get_internal_extent(extent);
+        if (values.dimensions() != cast<size_t>(internal_extent.size))
+            GRIDLIB_THROW("The size of the array doesn't match the extent.");
+        copy_values(internal_extent, values);
+    }
+
+    SignedExtent MultiGridReader::get_internal_extent(Extent extent) const
+    {
         extent = clamp(extent, cast<size_t>(data_->extent.size));
         auto internal_extent = cast<int64_t>(extent);
         internal_extent.origin += data_->extent.origin;
+        return internal_extent;
+    }
 
-        Grid result(cast<size_t>(internal_extent.size));
+    void MultiGridReader::assign_spatial_info(const SignedExtent& extent,
+                                              SpatialInfo& spatial_info) const
+    {
         const auto& first = data_->grids.front();
         const auto& first_si = first.spatial_info;
-        auto& si = result.spatial_info();
-        si = first_si;
-        si.tie_point = {0, 0};
+        // Copy assignment reuses the memory of the strings and vectors
+        // in spatial_info when it already has the same content.
+        spatial_info = first_si;
+        spatial_info.tie_point = {0, 0};
 
-        auto offsets = to_vector<double>(internal_extent.origin)
+        auto offsets = to_vector<double>(extent.origin)
                        - (first_si.tie_point
                           + to_vector<double>(first.extent.origin));
         const auto location = first_si.location()
                               + offsets[0] * first_si.column_axis()
                               + offsets[1] * first_si.row_axis();
-        si.set_location(location);
+        spatial_info.set_location(location);
+    }
 
-        for (const auto& grid_data : data_->grids)
-            load_and_copy_grid_data(result, grid_data, internal_extent);
+    void MultiGridReader::copy_values(const SignedExtent& extent,
+                                      Chorasmia::MutableArrayView2D<float> values) const
+    {
+        for (size_t i = 0; i < values.row_count(); ++i)
+        {
+            const auto row = values.row(i);
+            std::fill(row.begin(), row.end(), UNKNOWN_ELEVATION);
+        }
 
-        return result;
+        thread_local std::vector<size_t> grid_ids;
+        data_->index.find(extent, grid_ids);
+
+        MergeTarget target{values, {}, data_->merge_policy, grid_ids.size() == 1};
+        thread_local std::vector<uint32_t> counts;
+        if (!target.single_grid && target.policy == MultiGridMergePolicy::MEAN)
+        {
+            counts.assign(get_array_size(values.dimensions()), 0);
+            target.counts = {counts.data(), values.dimensions()};
+        }
+
+        for (const auto id : grid_ids)
+            load_and_copy_grid_data(target, data_->grids[id], extent);
+
+        if (target.counts.empty())
+            return;
+
+        for (size_t i = 0; i < values.row_count(); ++i)
+        {
+            auto count_it = target.counts.row(i).begin();
+            for (auto& value : values.row(i))
+            {
+                if (*count_it > 1)
+                    value /= float(*count_it);
+                ++count_it;
+            }
+        }
     }
 
-    void MultiGridReader::load_and_copy_grid_data(Grid& result,
-                                                  const GridData& grid_data,
-                                                  const SignedExtent& extent) const
+    void MultiGridReader::load_and_copy_grid_data(
+        const MergeTarget& target,
+        const GridData& grid_data,
+        const SignedExtent& extent) const
     {
         auto overlap = get_intersection(extent, grid_data.extent);
         if (!overlap)
@@ -211,25 +635,207 @@ namespace GridLib
         const auto copy_size = cast<size_t>(overlap->size);
 
         const auto src_size = cast<size_t>(grid_data.extent.size);
-        const auto buffer_size = get_array_size(src_size);
-        data_->buffer.resize(buffer_size);
-        data_->temp_file.stream().seekg(grid_data.temp_file_offset);
-        auto stream_size = std::streamsize(buffer_size * sizeof(float));
-        data_->temp_file.stream().read(reinterpret_cast<char*>(data_->buffer.data()), stream_size);
+        const Extent dst_extent{dst_start, copy_size};
+
+        if (data_->storage == MultiGridStorage::COMPRESSED_FILE)
+        {
+            load_and_merge_blocks(target, grid_data, {src_start, copy_size},
+                                  dst_start);
+            return;
+        }
+
+        if (!grid_data.on_demand
+            && data_->storage == MultiGridStorage::MEMORY_MAPPED_FILE)
+        {
+            const auto* values = reinterpret_cast<const float*>(
+                data_->mapped_file.data()
+                + std::streamoff(grid_data.temp_file_offset));
+            const auto src = Chorasmia::ArrayView2D(values, src_size)
+                .subarray({src_start, copy_size});
+            target.merge(src, dst_extent);
+            return;
+        }
+
+        if (data_->cache.accepts(get_array_size(src_size) * sizeof(float)))
+        {
+            auto tile = data_->cache.find(grid_data.z);
+            if (!tile)
+            {
+                tile = std::make_shared<const Chorasmia::Array2D<float>>(
+                    load_grid_values(grid_data));
+                data_->cache.insert(grid_data.z, tile);
+            }
+
+            const auto src = tile->view().subarray({src_start, copy_size});
+            target.merge(src, dst_extent);
+            return;
+        }
+
+        if (grid_data.on_demand)
+        {
+            const auto values = load_grid_values(grid_data);
+            const auto src = values.view().subarray({src_start, copy_size});
+            target.merge(src, dst_extent);
+            return;
+        }
+
+        // Read only the rows that overlap the extent. The buffer is
+        // thread local to allow concurrent calls to get_grid.
+        thread_local std::vector<float> buffer;
+        const auto [start_row, start_col] = src_start;
+        const Size rows_size(copy_size.rows, src_size.columns);
+        buffer.resize(get_array_size(rows_size));
+        const auto row_offset = start_row * src_size.columns * sizeof(float);
+        data_->file_reader.read(uint64_t(grid_data.temp_file_offset) + row_offset,
+                                buffer.data(), buffer.size() * sizeof(float));
+        const auto src = Chorasmia::ArrayView2D(buffer.data(), rows_size)
+            .subarray({{0, start_col}, copy_size});
+        target.merge(src, dst_extent);
+    }
+
+    void MultiGridReader::load_and_merge_blocks(const MergeTarget& target,
+                                                const GridData& grid_data,
+                                                const Extent& src_extent,
+                                                const Index& dst_start) const
+    {
+        const auto grid_size = cast<size_t>(grid_data.extent.size);
+        const auto block_cols = get_block_count(grid_size).columns;
+        const auto [first_row, first_col] = src_extent.origin;
+        const auto last_row = first_row + src_extent.size.rows - 1;
+        const auto last_col = first_col + src_extent.size.columns - 1;
+        const auto [dst_row, dst_col] = dst_start;
+
+        // Only the blocks that overlap src_extent are decompressed.
+        for (auto i = first_row / COMPRESSED_BLOCK_SIZE; i <= last_row / COMPRESSED_BLOCK_SIZE; ++i)
+        {
+            for (auto j = first_col / COMPRESSED_BLOCK_SIZE; j <= last_col / COMPRESSED_BLOCK_SIZE; ++j)
+            {
+                const auto block_extent = get_block_extent(i, j, grid_size);
+                const auto block_index = i * block_cols + j;
+                const auto block_size = block_extent.size;
+
+                TilePtr tile;
+                Chorasmia::ArrayView2D<float> block;
+                if (data_->cache.accepts(get_array_size(block_size) * sizeof(float)))
+                {
+                    // Blocks have their own keys as they are cached
+                    // individually rather than per grid.
+                    const auto key = grid_data.first_block_key + block_index;
+                    tile = data_->cache.find(key);
+                    if (!tile)
+                    {
+                        Chorasmia::Array2D<float> values(block_size);
+                        read_block(grid_data, block_index,
+                                   {values.data(), get_array_size(block_size)});
+                        tile = std::make_shared<const Chorasmia::Array2D<float>>(
+                            std::move(values));
+                        data_->cache.insert(key, tile);
+                    }
+                    block = tile->view();
+                }
+                else
+                {
+                    thread_local std::vector<float> buffer;
+                    buffer.resize(get_array_size(block_size));
+                    read_block(grid_data, block_index, buffer);
+                    block = Chorasmia::ArrayView2D<float>(buffer.data(), block_size);
+                }
+
+                const auto overlap = get_intersection(src_extent, block_extent);
+                const auto [row, col] = overlap->origin;
+                const auto [block_row, block_col] = block_extent.origin;
+                const auto src = block.subarray({{row - block_row, col - block_col},
+                                                 overlap->size});
+                target.merge(src, {{dst_row + row - first_row, dst_col + col - first_col},
+                                   overlap->size});
+            }
+        }
+    }
+
+    void MultiGridReader::read_block(const GridData& grid_data,
+                                     size_t block_index,
+                                     std::span<float> values) const
+    {
+        const auto offset = grid_data.block_offsets[block_index];
+        const auto size = grid_data.block_offsets[block_index + 1] - offset;
+        thread_local std::vector<char> buffer;
+        buffer.resize(size);
+        data_->file_reader.read(offset, buffer.data(), size);
+        decompress_floats(buffer, values);
+    }
+
+    Chorasmia::Array2D<float>
+    MultiGridReader::load_grid_values(const GridData& grid_data) const
+    {
+        const auto size = cast<size_t>(grid_data.extent.size);
+        if (grid_data.on_demand)
+        {
+            auto grid = GridLib::read_grid(grid_data.filename,
+                                           GridFileType::AUTO_DETECT);
+            if (grid.size() != size)
+                GRIDLIB_THROW("The size of the grid in " + grid_data.filename.string()
+                              + " has changed.");
+            return grid.release();
+        }
+
+        Chorasmia::Array2D<float> values(size);
+        data_->file_reader.read(uint64_t(grid_data.temp_file_offset),
+                                values.data(),
+                                get_array_size(size) * sizeof(float));
+        return values;
+    }
+
+    SignedIndex
+    MultiGridReader::get_insertion_point(const SpatialInfo& spatial_info) const
+    {
+        if (data_->grids.empty())
+            return {};
+
+        const auto& first = data_->grids.front();
+        return GridLib::get_insertion_point(
+            spatial_info,
+            PositionTransformer(first.spatial_info.matrix, first.tie_point));
+    }
+
+    void MultiGridReader::add_grid_info(GridInfo info,
+                                        const std::filesystem::path& filename)
+    {
+        if (get_array_size(info.size) == 0)
+            return;
+
+        assert_compatible_grid(info.spatial_info);
+        const auto origin = get_insertion_point(info.spatial_info);
+        const auto tie_point = info.spatial_info.tie_point;
+        add_grid_data({
+            filename,
+            true,
+            0,
+            {origin, cast<int64_t>(info.size)},
+            tie_point,
+            std::move(info.spatial_info)
+        });
+    }
+
+    void MultiGridReader::add_grid_data(GridData grid_data)
+    {
+        grid_data.z = data_->grids.size();
+        data_->index.insert(grid_data.extent);
+
+        const auto min = get_min(data_->extent.min_index(),
+                                 grid_data.extent.min_index());
+        const auto max = get_max(data_->extent.max_index(),
+                                 grid_data.extent.max_index());
+        data_->extent = {min, max - min};
 
-        const auto src = Chorasmia::ArrayView2D(data_->buffer.data(), src_size)
-            .subarray({src_start, copy_size});
-        const auto dst = result.values().subarray({dst_start, copy_size});
-        Chorasmia::copy(src, dst, Chorasmia::Index2DMode::ROWS);
+        data_->grids.push_back(std::move(grid_data));
     }
 
-    void MultiGridReader::assert_compatible_grid(const Grid& grid) const
+    void MultiGridReader::assert_compatible_grid(const SpatialInfo& si) const
     {
         if (data_->grids.empty())
             return;
 
         const auto& first = data_->grids.front();
-        const auto& si = grid.spatial_info();
         if (si.row_axis() != first.spatial_info.row_axis())
             GRIDLIB_THROW("The row axes don't match.");
         if (si.column_axis() != first.spatial_info.column_axis())
@@ -0,0 +1,48 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GridLib/MultiGridTileIterator.hpp"
+
+namespace GridLib
+{
+    MultiGridTileIterator::MultiGridTileIterator(const MultiGridReader& reader,
+                                                 const Size& tile_size)
+        : reader_(&reader),
+          extents_(reader.get_tiles_with_data(tile_size))
+    {
+    }
+
+    bool MultiGridTileIterator::next()
+    {
+        if (next_index_ == extents_.size())
+            return false;
+
+        extent_ = extents_[next_index_++];
+        reader_->get_grid_into(extent_, grid_);
+        return true;
+    }
+
+    const Extent& MultiGridTileIterator::extent() const
+    {
+        return extent_;
+    }
+
+    const Grid& MultiGridTileIterator::grid() const
+    {
+        return grid_;
+    }
+
+    Grid& MultiGridTileIterator::grid()
+    {
+        return grid_;
+    }
+
+    size_t MultiGridTileIterator::tile_count() const
+    {
+        return extents_.size();
+    }
+}
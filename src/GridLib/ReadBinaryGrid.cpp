@@ -0,0 +1,264 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GridLib/ReadBinaryGrid.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <Yson/ReaderIterators.hpp>
+
+#include "GridLib/GridLibException.hpp"
+#include "GridLib/GridView.hpp"
+#include "GridLib/ReadJsonGrid.hpp"
+#include "Utilities/MemoryMappedFile.hpp"
+#include "BinaryGridFormat.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        struct BinaryGridHeader
+        {
+            size_t payload_offset = 0;
+            size_t model_size = 0;
+            Size size;
+        };
+
+        BinaryGridHeader read_header(const char* data, size_t size)
+        {
+            if (size < BINARY_GRID_FIXED_HEADER_SIZE
+                || std::string_view(data, BINARY_GRID_MAGIC.size()) != BINARY_GRID_MAGIC)
+            {
+                GRIDLIB_THROW("Not a binary grid.");
+            }
+
+            if (auto version = read_little_endian<uint32_t>(data + 8);
+                version != BINARY_GRID_VERSION)
+            {
+                GRIDLIB_THROW("Unsupported binary grid version: "
+                              + std::to_string(version));
+            }
+
+            BinaryGridHeader header;
+            header.payload_offset = read_little_endian<uint32_t>(data + 12);
+            header.size.rows = read_little_endian<uint64_t>(data + 16);
+            header.size.columns = read_little_endian<uint64_t>(data + 24);
+            header.model_size = read_little_endian<uint32_t>(data + 32);
+
+            if (header.payload_offset % BINARY_GRID_ALIGNMENT != 0
+                || header.payload_offset < BINARY_GRID_FIXED_HEADER_SIZE
+                                           + header.model_size)
+            {
+                GRIDLIB_THROW("Invalid binary grid header.");
+            }
+            return header;
+        }
+
+        size_t get_payload_size(const BinaryGridHeader& header)
+        {
+            const auto [rows, cols] = header.size;
+            if (cols != 0 && rows > SIZE_MAX / sizeof(float) / cols)
+                GRIDLIB_THROW("Binary grid is too large.");
+            return rows * cols * sizeof(float);
+        }
+
+        SpatialInfo read_header_model(const char* data,
+                                      const BinaryGridHeader& header)
+        {
+            return read_model(*Yson::makeReader(data + BINARY_GRID_FIXED_HEADER_SIZE,
+                                                header.model_size));
+        }
+
+        void check_file_size(const BinaryGridHeader& header, size_t size)
+        {
+            if (size < header.payload_offset
+                || size - header.payload_offset < get_payload_size(header))
+            {
+                GRIDLIB_THROW("Binary grid is truncated.");
+            }
+        }
+
+        void read_values(const char* data, Chorasmia::MutableArrayView2D<float> values)
+        {
+            auto array = values.array();
+            std::memcpy(array.data(), data, array.size() * sizeof(float));
+            if constexpr (std::endian::native != std::endian::little)
+                std::ranges::transform(array, array.begin(), little_endian<float>);
+        }
+
+        Grid read_grid_data(const char* data, size_t size)
+        {
+            const auto header = read_header(data, size);
+            check_file_size(header, size);
+            Grid grid(header.size);
+            grid.spatial_info() = read_header_model(data, header);
+            read_values(data + header.payload_offset, grid.values());
+            return grid;
+        }
+
+        /**
+         * Appends @a count elements from @a stream to @a buffer. The count
+         * comes from the file's header, so memory is allocated in chunks
+         * as the data arrives rather than all at once.
+         */
+        template <typename Container>
+        void read_chunked(std::istream& stream, Container& buffer, size_t count)
+        {
+            using T = typename Container::value_type;
+            constexpr size_t CHUNK_SIZE = (size_t(64) << 20) / sizeof(T);
+            const auto end = buffer.size() + count;
+            while (buffer.size() < end)
+            {
+                const auto offset = buffer.size();
+                const auto chunk = std::min(end - offset, CHUNK_SIZE);
+                buffer.resize(offset + chunk);
+                const auto bytes = std::streamsize(chunk * sizeof(T));
+                stream.read(reinterpret_cast<char*>(buffer.data() + offset), bytes);
+                if (stream.gcount() != bytes)
+                    GRIDLIB_THROW("Binary grid is truncated.");
+            }
+        }
+
+        std::string read_stream_header(std::istream& stream, BinaryGridHeader& header)
+        {
+            std::string buffer(BINARY_GRID_FIXED_HEADER_SIZE, '\0');
+            stream.read(buffer.data(), std::streamsize(buffer.size()));
+            header = read_header(buffer.data(), size_t(stream.gcount()));
+            read_chunked(stream, buffer,
+                         header.payload_offset - BINARY_GRID_FIXED_HEADER_SIZE);
+            return buffer;
+        }
+    }
+
+    Grid read_binary_grid(std::istream& stream)
+    {
+        BinaryGridHeader header;
+        const auto buffer = read_stream_header(stream, header);
+        std::vector<float> values;
+        read_chunked(stream, values, get_payload_size(header) / sizeof(float));
+        if constexpr (std::endian::native != std::endian::little)
+            std::ranges::transform(values, values.begin(), little_endian<float>);
+        Grid grid(Chorasmia::Array2D<float>(std::move(values), header.size));
+        grid.spatial_info() = read_header_model(buffer.data(), header);
+        return grid;
+    }
+
+    Grid read_binary_grid(const void* buffer, size_t size)
+    {
+        return read_grid_data(static_cast<const char*>(buffer), size);
+    }
+
+    Grid read_binary_grid(const std::filesystem::path& filename)
+    {
+        const MemoryMappedFile file(filename);
+        return read_grid_data(file.data(), file.size());
+    }
+
+    GridInfo read_binary_grid_info(const std::filesystem::path& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file)
+            GRIDLIB_THROW("Can not open file: " + filename.string());
+        BinaryGridHeader header;
+        const auto buffer = read_stream_header(file, header);
+        return {header.size, read_header_model(buffer.data(), header)};
+    }
+
+    bool is_binary_grid(const std::filesystem::path& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        char magic[BINARY_GRID_MAGIC.size()];
+        file.read(magic, sizeof(magic));
+        return file && is_binary_grid(magic, sizeof(magic));
+    }
+
+    bool is_binary_grid(const void* buffer, size_t size)
+    {
+        return size >= BINARY_GRID_MAGIC.size()
+               && std::string_view(static_cast<const char*>(buffer),
+                                   BINARY_GRID_MAGIC.size()) == BINARY_GRID_MAGIC;
+    }
+
+    struct MappedGrid::Data
+    {
+        MemoryMappedFile file;
+        SpatialInfo spatial_info;
+        Chorasmia::ArrayView2D<float> values;
+    };
+
+    MappedGrid::MappedGrid() = default;
+
+    MappedGrid::MappedGrid(const std::filesystem::path& filename)
+    {
+        if constexpr (std::endian::native != std::endian::little)
+            GRIDLIB_THROW("Binary grids can only be mapped on little-endian hosts.");
+
+        MemoryMappedFile file(filename);
+        const auto header = read_header(file.data(), file.size());
+        check_file_size(header, file.size());
+        auto model = read_header_model(file.data(), header);
+        const auto* values = reinterpret_cast<const float*>(file.data()
+                                                            + header.payload_offset);
+        data_ = std::make_unique<Data>(Data{
+            std::move(file),
+            std::move(model),
+            Chorasmia::ArrayView2D<float>(values, {header.size.rows,
+                                                   header.size.columns})
+        });
+    }
+
+    MappedGrid::MappedGrid(MappedGrid&& other) noexcept = default;
+
+    MappedGrid::~MappedGrid() = default;
+
+    MappedGrid& MappedGrid::operator=(MappedGrid&& other) noexcept = default;
+
+    bool MappedGrid::empty() const
+    {
+        return !data_;
+    }
+
+    GridView MappedGrid::view() const
+    {
+        if (!data_)
+            return {};
+        return GridView(data_->values, &data_->spatial_info);
+    }
+
+    Size MappedGrid::size() const
+    {
+        if (!data_)
+            return {};
+        return {data_->values.row_count(), data_->values.col_count()};
+    }
+
+    Xyz::Vector2D MappedGrid::tie_point() const
+    {
+        return spatial_info().tie_point;
+    }
+
+    const SpatialInfo& MappedGrid::spatial_info() const
+    {
+        if (!data_)
+            GRIDLIB_THROW("grid is NULL");
+        return data_->spatial_info;
+    }
+
+    Chorasmia::ArrayView2D<float> MappedGrid::values() const
+    {
+        if (!data_)
+            return {};
+        return data_->values;
+    }
+
+    GridView MappedGrid::subgrid(const Index& index, const Size& size) const
+    {
+        return view().subgrid(index, size);
+    }
+}
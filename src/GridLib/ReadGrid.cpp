@@ -12,7 +12,9 @@
 
 #include "GridBuilder.hpp"
 #include "GridLib/GridLibException.hpp"
+#include "GridLib/ReadBinaryGrid.hpp"
 #include "GridLib/ReadJsonGrid.hpp"
+#include "GridLib/ReadUBJsonGrid.hpp"
 #include "GridLibVersion.hpp"
 
 #ifdef GridLib_DEM_SUPPORT
@@ -34,7 +36,10 @@ namespace GridLib
         {
         CASE_ENUM(GridFileType, UNKNOWN);
         CASE_ENUM(GridFileType, GRIDLIB_JSON);
+        CASE_ENUM(GridFileType, GRIDLIB_BINARY);
+        CASE_ENUM(GridFileType, GRIDLIB_UBJSON);
         CASE_ENUM(GridFileType, DEM);
+        CASE_ENUM(GridFileType, GEOTIFF);
         CASE_ENUM(GridFileType, AUTO_DETECT);
         default:
             GRIDLIB_THROW("Unknown GridFileType: "
@@ -48,6 +53,10 @@ namespace GridLib
         {
         case GridFileType::GRIDLIB_JSON:
             return read_json_grid(stream);
+        case GridFileType::GRIDLIB_BINARY:
+            return read_binary_grid(stream);
+        case GridFileType::GRIDLIB_UBJSON:
+            return read_ubjson_grid(stream);
 #ifdef GridLib_DEM_SUPPORT
         case GridFileType::DEM:
             return read_dem(stream);
@@ -63,6 +72,8 @@ namespace GridLib
 
     GridFileType detect_file_type(const std::filesystem::path& fileName)
     {
+        if (is_binary_grid(fileName))
+            return GridFileType::GRIDLIB_BINARY;
 #ifdef GridLib_DEM_SUPPORT
         if (is_dem(fileName))
             return GridFileType::DEM;
@@ -71,6 +82,8 @@ namespace GridLib
         if (is_tiff(fileName))
             return GridFileType::GEOTIFF;
 #endif
+        if (is_ubjson_grid(fileName))
+            return GridFileType::GRIDLIB_UBJSON;
         if (Yson::makeReader(fileName))
             return GridFileType::GRIDLIB_JSON;
         return GridFileType::UNKNOWN;
@@ -85,6 +98,10 @@ namespace GridLib
         {
         case GridFileType::GRIDLIB_JSON:
             return read_json_grid(filename);
+        case GridFileType::GRIDLIB_BINARY:
+            return read_binary_grid(filename);
+        case GridFileType::GRIDLIB_UBJSON:
+            return read_ubjson_grid(filename);
 #ifdef GridLib_DEM_SUPPORT
         case GridFileType::DEM:
             return read_dem(filename);
@@ -98,12 +115,41 @@ namespace GridLib
         }
     }
 
+    GridInfo read_grid_info(const std::filesystem::path& filename,
+                            GridFileType type)
+    {
+        if (type == GridFileType::AUTO_DETECT)
+            type = detect_file_type(filename);
+
+        if (type == GridFileType::GRIDLIB_JSON)
+            return read_json_grid_info(filename);
+        if (type == GridFileType::GRIDLIB_BINARY)
+            return read_binary_grid_info(filename);
+        if (type == GridFileType::GRIDLIB_UBJSON)
+            return read_ubjson_grid_info(filename);
+#ifdef GridLib_DEM_SUPPORT
+        if (type == GridFileType::DEM)
+            return read_dem_info(filename);
+#endif
+#ifdef GridLib_GEOTIFF_SUPPORT
+        if (type == GridFileType::GEOTIFF)
+            return read_geotiff_info(filename);
+#endif
+
+        auto grid = read_grid(filename, type);
+        return {grid.size(), std::move(grid.spatial_info())};
+    }
+
     Grid read_grid(const void* buffer, size_t size, GridFileType type)
     {
         switch (type)
         {
         case GridFileType::GRIDLIB_JSON:
             return read_json_grid(buffer, size);
+        case GridFileType::GRIDLIB_BINARY:
+            return read_binary_grid(buffer, size);
+        case GridFileType::GRIDLIB_UBJSON:
+            return read_ubjson_grid(buffer, size);
 #ifdef GridLib_DEM_SUPPORT
         case GridFileType::DEM:
             return read_dem(buffer, size);
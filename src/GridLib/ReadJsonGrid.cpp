@@ -7,17 +7,30 @@
 //****************************************************************************
 #include "GridLib/ReadJsonGrid.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <map>
+#include <optional>
+#include <type_traits>
 #include <Yson/ReaderIterators.hpp>
 
 #include "GridBuilder.hpp"
 #include "GridLib/GridLibException.hpp"
+#include "Utilities/FloatFromChars.hpp"
+#include "Utilities/MemoryMappedFile.hpp"
 
 namespace GridLib
 {
     namespace
     {
+        /**
+         * The largest number of elevations reserved before reading them
+         * with Yson. The grid size comes from the file and the input size
+         * is unknown, so larger grids grow as they are read.
+         */
+        constexpr size_t MAX_RESERVED_ELEVATIONS = size_t(1) << 24;
+
         std::string get_reader_position(Yson::Reader& reader)
         {
             return " [line " + std::to_string(reader.lineNumber())
@@ -135,10 +148,11 @@ namespace GridLib
         return result;
     }
 
-    std::vector<float> read_elevations(Yson::Reader& reader)
+    std::vector<float> read_elevations(Yson::Reader& reader, size_t count)
     {
         using Yson::read;
         std::vector<float> result;
+        result.reserve(std::min(count, MAX_RESERVED_ELEVATIONS));
         for (Yson::ArrayIterator row_it(reader); row_it.next();)
         {
             for (Yson::ArrayIterator col_it(reader); col_it.next();)
@@ -164,13 +178,292 @@ namespace GridLib
             else if (key == "model")
                 builder.model = read_model(reader, strict);
             else if (key == "elevations")
-                builder.values = read_elevations(reader);
+                builder.values = read_elevations(reader, builder.row_count
+                                                         * builder.col_count);
             else if (strict)
                 GRIDLIB_THROW("Unknown key: '" + key + "'" + get_reader_position(reader));
         }
         return builder.build();
     }
 
+    GridInfo read_grid_info(Yson::Reader& reader, bool strict)
+    {
+        GridInfo result;
+        for (const auto& key : keys(reader))
+        {
+            if (key == "row_count")
+                result.size.rows = read<uint32_t>(reader);
+            else if (key == "column_count")
+                result.size.columns = read<uint32_t>(reader);
+            else if (key == "model")
+                result.spatial_info = read_model(reader, strict);
+            else if (key != "elevations" && strict)
+                GRIDLIB_THROW("Unknown key: '" + key + "'" + get_reader_position(reader));
+        }
+        return result;
+    }
+
+    namespace
+    {
+        /**
+         * @brief A minimal scanner for the JSON text written by
+         *  write_json(std::ostream&, const IGrid&).
+         *
+         * It only understands what it needs to read the elevations
+         * directly with float_from_chars; all functions return false or
+         * an empty value on anything unexpected.
+         */
+        class JsonGridScanner
+        {
+        public:
+            explicit JsonGridScanner(std::string_view text)
+                : pos_(text.data()),
+                  end_(text.data() + text.size())
+            {}
+
+            [[nodiscard]]
+            size_t remaining() const
+            {
+                return size_t(end_ - pos_);
+            }
+
+            bool at_end()
+            {
+                skip_whitespace();
+                return pos_ == end_;
+            }
+
+            bool consume(char c)
+            {
+                skip_whitespace();
+                if (pos_ == end_ || *pos_ != c)
+                    return false;
+                ++pos_;
+                return true;
+            }
+
+            std::optional<std::string_view> read_key()
+            {
+                if (!consume('"'))
+                    return {};
+                const auto* start = pos_;
+                while (pos_ != end_ && *pos_ != '"')
+                {
+                    if (*pos_ == '\\')
+                        return {};
+                    ++pos_;
+                }
+                if (pos_ == end_)
+                    return {};
+                std::string_view key(start, size_t(pos_ - start));
+                ++pos_;
+                if (!consume(':'))
+                    return {};
+                return key;
+            }
+
+            template <typename T>
+            bool read_number(T& value)
+            {
+                skip_whitespace();
+                std::from_chars_result result;
+                if constexpr (std::is_floating_point_v<T>)
+                    result = float_from_chars(pos_, end_, value);
+                else
+                    result = std::from_chars(pos_, end_, value);
+                const auto [ptr, ec] = result;
+                if (ec != std::errc())
+                    return false;
+                pos_ = ptr;
+                return true;
+            }
+
+            bool read_elevation(float& value)
+            {
+                skip_whitespace();
+                if (remaining() >= 4 && std::string_view(pos_, 4) == "null")
+                {
+                    pos_ += 4;
+                    value = UNKNOWN_ELEVATION;
+                    return true;
+                }
+                return read_number(value);
+            }
+
+            std::optional<std::string_view> skip_value()
+            {
+                skip_whitespace();
+                const auto* start = pos_;
+                int depth = 0;
+                while (pos_ != end_)
+                {
+                    switch (*pos_)
+                    {
+                    case '"':
+                        if (!skip_string())
+                            return {};
+                        continue;
+                    case '[':
+                    case '{':
+                        ++depth;
+                        break;
+                    case ']':
+                    case '}':
+                        if (depth == 0)
+                            return std::string_view(start, size_t(pos_ - start));
+                        --depth;
+                        break;
+                    case ',':
+                        if (depth == 0)
+                            return std::string_view(start, size_t(pos_ - start));
+                        break;
+                    default:
+                        break;
+                    }
+                    ++pos_;
+                }
+                return {};
+            }
+
+        private:
+            void skip_whitespace()
+            {
+                while (pos_ != end_ && (*pos_ == ' ' || *pos_ == '\n'
+                                        || *pos_ == '\r' || *pos_ == '\t'))
+                {
+                    ++pos_;
+                }
+            }
+
+            bool skip_string()
+            {
+                for (++pos_; pos_ != end_; ++pos_)
+                {
+                    if (*pos_ == '\\')
+                    {
+                        if (++pos_ == end_)
+                            return false;
+                    }
+                    else if (*pos_ == '"')
+                    {
+                        ++pos_;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            const char* pos_;
+            const char* end_;
+        };
+
+        /**
+         * Reads a row or column count. The counts are 32-bit, like in
+         * read_grid(Yson::Reader&, bool), so both readers reject the
+         * same documents.
+         */
+        bool read_count(JsonGridScanner& scanner, size_t& count)
+        {
+            uint32_t value;
+            if (!scanner.read_number(value))
+                return false;
+            count = value;
+            return true;
+        }
+
+        bool read_elevations(JsonGridScanner& scanner, GridBuilder& builder)
+        {
+            // Every elevation takes up at least two characters, which
+            // limits the damage done by a corrupt row or column count.
+            builder.values.reserve(std::min(builder.row_count * builder.col_count,
+                                            scanner.remaining() / 2));
+            if (!scanner.consume('['))
+                return false;
+            if (scanner.consume(']'))
+                return true;
+            do
+            {
+                if (!scanner.consume('['))
+                    return false;
+                if (scanner.consume(']'))
+                    continue;
+                do
+                {
+                    float value;
+                    if (!scanner.read_elevation(value))
+                        return false;
+                    builder.values.push_back(value);
+                } while (scanner.consume(','));
+                if (!scanner.consume(']'))
+                    return false;
+            } while (scanner.consume(','));
+            return scanner.consume(']')
+                   && builder.values.size() == builder.row_count * builder.col_count;
+        }
+
+        /**
+         * @brief Reads a JSON grid whose row and column counts precede
+         *  its elevations, as written by write_json.
+         *
+         * Returns an empty value if the text has any other layout, the
+         * caller must then fall back on the generic Yson-based reader.
+         */
+        std::optional<Grid> read_grid_fast(std::string_view text, bool strict)
+        {
+            JsonGridScanner scanner(text);
+            if (!scanner.consume('{'))
+                return {};
+
+            GridBuilder builder;
+            bool has_row_count = false;
+            bool has_col_count = false;
+            do
+            {
+                const auto key = scanner.read_key();
+                if (!key)
+                    return {};
+
+                if (*key == "row_count")
+                {
+                    if (!read_count(scanner, builder.row_count))
+                        return {};
+                    has_row_count = true;
+                }
+                else if (*key == "column_count")
+                {
+                    if (!read_count(scanner, builder.col_count))
+                        return {};
+                    has_col_count = true;
+                }
+                else if (*key == "model")
+                {
+                    const auto model = scanner.skip_value();
+                    if (!model)
+                        return {};
+                    builder.model = read_model(*Yson::makeReader(model->data(),
+                                                                 model->size()),
+                                               strict);
+                }
+                else if (*key == "elevations")
+                {
+                    if (!has_row_count || !has_col_count
+                        || !read_elevations(scanner, builder))
+                    {
+                        return {};
+                    }
+                }
+                else if (strict || !scanner.skip_value())
+                {
+                    return {};
+                }
+            } while (scanner.consume(','));
+
+            if (!scanner.consume('}') || !scanner.at_end())
+                return {};
+            return builder.build();
+        }
+    }
+
     Grid read_json_grid(std::istream& stream, bool strict)
     {
         return read_grid(*Yson::makeReader(stream), strict);
@@ -178,12 +471,25 @@ namespace GridLib
 
     Grid read_json_grid(const std::filesystem::path& filename, bool strict)
     {
+        {
+            const MemoryMappedFile file(filename);
+            if (auto grid = read_grid_fast(file.view(), strict))
+                return std::move(*grid);
+        }
         return read_grid(*Yson::makeReader(filename), strict);
     }
 
     Grid read_json_grid(const void* buffer, size_t size, bool strict)
     {
         auto str = static_cast<const char*>(buffer);
+        if (auto grid = read_grid_fast({str, size}, strict))
+            return std::move(*grid);
         return read_grid(*Yson::makeReader(str, size), strict);
     }
+
+    GridInfo read_json_grid_info(const std::filesystem::path& filename,
+                                 bool strict)
+    {
+        return read_grid_info(*Yson::makeReader(filename), strict);
+    }
 }
@@ -0,0 +1,393 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GridLib/ReadUBJsonGrid.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <Yson/ReaderIterators.hpp>
+
+#include "GridBuilder.hpp"
+#include "GridLib/ReadJsonGrid.hpp"
+#include "Utilities/ByteOrder.hpp"
+#include "Utilities/MemoryMappedFile.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        /**
+         * @brief A minimal scanner for UBJSON grids.
+         *
+         * It reads the elevations with a single memcpy per row when they
+         * are stored as optimized float32 arrays, as write_ubjson does.
+         * All functions return false or an empty value on anything
+         * unexpected.
+         */
+        class UBJsonGridScanner
+        {
+        public:
+            explicit UBJsonGridScanner(std::string_view data)
+                : pos_(data.data()),
+                  end_(data.data() + data.size())
+            {}
+
+            [[nodiscard]]
+            bool at_end() const
+            {
+                return pos_ == end_;
+            }
+
+            [[nodiscard]]
+            size_t remaining() const
+            {
+                return size_t(end_ - pos_);
+            }
+
+            bool next_marker(char& marker)
+            {
+                // 'N' is UBJSON's no-op marker.
+                while (pos_ != end_ && *pos_ == 'N')
+                    ++pos_;
+                if (pos_ == end_)
+                    return false;
+                marker = *pos_++;
+                return true;
+            }
+
+            bool consume(char marker)
+            {
+                const auto* pos = pos_;
+                char c;
+                if (next_marker(c) && c == marker)
+                    return true;
+                pos_ = pos;
+                return false;
+            }
+
+            std::optional<int64_t> read_integer()
+            {
+                char marker;
+                if (!next_marker(marker))
+                    return {};
+                return read_integer(marker);
+            }
+
+            std::optional<std::string_view> read_key()
+            {
+                const auto length = read_integer();
+                if (!length || *length < 0 || !has_bytes(size_t(*length)))
+                    return {};
+                std::string_view key(pos_, size_t(*length));
+                pos_ += *length;
+                return key;
+            }
+
+            std::optional<std::string_view> skip_value()
+            {
+                const auto* start = pos_;
+                char marker;
+                if (!next_marker(marker) || !skip_value(marker))
+                    return {};
+                return std::string_view(start, size_t(pos_ - start));
+            }
+
+            bool read_float32_array(std::vector<float>& values)
+            {
+                if (!consume('[') || !consume('$') || !consume('d') || !consume('#'))
+                    return false;
+                const auto count = read_integer();
+                if (!count || *count < 0
+                    || size_t(*count) > size_t(end_ - pos_) / sizeof(float))
+                {
+                    return false;
+                }
+
+                const auto offset = values.size();
+                values.resize(offset + size_t(*count));
+                const auto dst = std::span(values).subspan(offset);
+                std::memcpy(dst.data(), pos_, dst.size_bytes());
+                pos_ += dst.size_bytes();
+                if constexpr (std::endian::native != std::endian::big)
+                    std::ranges::transform(dst, dst.begin(), big_endian<float>);
+                return true;
+            }
+
+        private:
+            [[nodiscard]]
+            bool has_bytes(size_t n) const
+            {
+                return size_t(end_ - pos_) >= n;
+            }
+
+            template <typename T>
+            std::optional<int64_t> read_big_endian_integer()
+            {
+                if (!has_bytes(sizeof(T)))
+                    return {};
+                const auto value = read_big_endian<T>(pos_);
+                pos_ += sizeof(T);
+                return int64_t(value);
+            }
+
+            std::optional<int64_t> read_integer(char marker)
+            {
+                switch (marker)
+                {
+                case 'i': return read_big_endian_integer<int8_t>();
+                case 'U': return read_big_endian_integer<uint8_t>();
+                case 'I': return read_big_endian_integer<int16_t>();
+                case 'l': return read_big_endian_integer<int32_t>();
+                case 'L': return read_big_endian_integer<int64_t>();
+                default: return {};
+                }
+            }
+
+            static size_t get_fixed_size(char marker)
+            {
+                switch (marker)
+                {
+                case 'Z': case 'T': case 'F': return 0;
+                case 'i': case 'U': case 'C': return 1;
+                case 'I': return 2;
+                case 'l': case 'd': return 4;
+                case 'L': case 'D': return 8;
+                default: return SIZE_MAX;
+                }
+            }
+
+            bool skip_bytes(size_t n)
+            {
+                if (!has_bytes(n))
+                    return false;
+                pos_ += n;
+                return true;
+            }
+
+            bool skip_value(char marker)
+            {
+                switch (marker)
+                {
+                case 'S':
+                case 'H':
+                    return read_key().has_value();
+                case '[':
+                    return skip_container(false);
+                case '{':
+                    return skip_container(true);
+                default:
+                    if (const auto size = get_fixed_size(marker); size != SIZE_MAX)
+                        return skip_bytes(size);
+                    return false;
+                }
+            }
+
+            bool skip_container(bool is_object)
+            {
+                char type = 0;
+                if (consume('$') && !next_marker(type))
+                    return false;
+
+                std::optional<int64_t> count;
+                if (consume('#'))
+                {
+                    count = read_integer();
+                    if (!count || *count < 0)
+                        return false;
+                }
+                else if (type)
+                {
+                    return false;
+                }
+
+                if (count && type && !is_object)
+                {
+                    const auto size = get_fixed_size(type);
+                    if (size != SIZE_MAX)
+                    {
+                        if (size != 0 && size_t(*count) > size_t(end_ - pos_) / size)
+                            return false;
+                        return skip_bytes(size_t(*count) * size);
+                    }
+                }
+
+                for (int64_t i = 0; !count || i < *count; ++i)
+                {
+                    if (!count && consume(is_object ? '}' : ']'))
+                        return true;
+                    if (is_object && !read_key())
+                        return false;
+                    char marker = type;
+                    if (!type && !next_marker(marker))
+                        return false;
+                    if (!skip_value(marker))
+                        return false;
+                }
+                return true;
+            }
+
+            const char* pos_;
+            const char* end_;
+        };
+
+        bool read_count(UBJsonGridScanner& scanner, size_t& count)
+        {
+            const auto value = scanner.read_integer();
+            if (!value || *value < 0)
+                return false;
+            count = size_t(*value);
+            return true;
+        }
+
+        bool read_elevations(UBJsonGridScanner& scanner, GridBuilder& builder)
+        {
+            if (!scanner.consume('['))
+                return false;
+
+            const bool is_counted = scanner.consume('#');
+            if (is_counted && scanner.read_integer() != int64_t(builder.row_count))
+                return false;
+
+            builder.values.reserve(std::min(builder.row_count * builder.col_count,
+                                            scanner.remaining() / sizeof(float)));
+            for (size_t i = 0; i < builder.row_count; ++i)
+            {
+                if (!scanner.read_float32_array(builder.values)
+                    || builder.values.size() != (i + 1) * builder.col_count)
+                {
+                    return false;
+                }
+            }
+            return is_counted || scanner.consume(']');
+        }
+
+        SpatialInfo read_model_data(std::string_view data, bool strict)
+        {
+            return read_model(*Yson::makeReader(data.data(), data.size()), strict);
+        }
+
+        /**
+         * @brief Reads the grid's size, model and optionally elevations.
+         *
+         * Returns false if the grid isn't laid out as written by
+         * write_ubjson, the caller must then fall back on Yson's reader.
+         */
+        bool read_grid_fast(std::string_view data, bool strict,
+                            bool read_values, GridBuilder& builder)
+        {
+            UBJsonGridScanner scanner(data);
+            if (!scanner.consume('{'))
+                return false;
+
+            bool has_row_count = false;
+            bool has_col_count = false;
+            while (!scanner.consume('}'))
+            {
+                const auto key = scanner.read_key();
+                if (!key)
+                    return false;
+
+                if (*key == "row_count")
+                {
+                    if (!read_count(scanner, builder.row_count))
+                        return false;
+                    has_row_count = true;
+                }
+                else if (*key == "column_count")
+                {
+                    if (!read_count(scanner, builder.col_count))
+                        return false;
+                    has_col_count = true;
+                }
+                else if (*key == "model")
+                {
+                    const auto model = scanner.skip_value();
+                    if (!model)
+                        return false;
+                    builder.model = read_model_data(*model, strict);
+                }
+                else if (*key == "elevations" && read_values)
+                {
+                    if (!has_row_count || !has_col_count
+                        || !read_elevations(scanner, builder))
+                    {
+                        return false;
+                    }
+                }
+                else if ((strict && *key != "elevations") || !scanner.skip_value())
+                {
+                    return false;
+                }
+            }
+            return scanner.at_end();
+        }
+
+        std::optional<Grid> read_grid_fast(std::string_view data, bool strict)
+        {
+            GridBuilder builder;
+            if (!read_grid_fast(data, strict, true, builder))
+                return {};
+            return builder.build();
+        }
+    }
+
+    Grid read_ubjson_grid(std::istream& stream, bool strict)
+    {
+        std::ostringstream buffer;
+        buffer << stream.rdbuf();
+        const auto data = std::move(buffer).str();
+        return read_ubjson_grid(data.data(), data.size(), strict);
+    }
+
+    Grid read_ubjson_grid(const std::filesystem::path& filename, bool strict)
+    {
+        const MemoryMappedFile file(filename);
+        return read_ubjson_grid(file.data(), file.size(), strict);
+    }
+
+    Grid read_ubjson_grid(const void* buffer, size_t size, bool strict)
+    {
+        const std::string_view data(static_cast<const char*>(buffer), size);
+        if (auto grid = read_grid_fast(data, strict))
+            return std::move(*grid);
+        return read_json_grid(buffer, size, strict);
+    }
+
+    GridInfo read_ubjson_grid_info(const std::filesystem::path& filename,
+                                   bool strict)
+    {
+        {
+            const MemoryMappedFile file(filename);
+            GridBuilder builder;
+            if (read_grid_fast(file.view(), strict, false, builder))
+                return {{builder.row_count, builder.col_count}, std::move(builder.model)};
+        }
+        return read_json_grid_info(filename, strict);
+    }
+
+    bool is_ubjson_grid(const std::filesystem::path& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        char header[2];
+        file.read(header, sizeof(header));
+        return file && is_ubjson_grid(header, sizeof(header));
+    }
+
+    bool is_ubjson_grid(const void* buffer, size_t size)
+    {
+        // A UBJSON grid starts with '{' followed by the length of the
+        // first key, or a count or type marker. '}' and the no-op marker
+        // 'N' are not accepted, "{}" is valid JSON and not a grid.
+        const auto* data = static_cast<const char*>(buffer);
+        return size >= 2 && data[0] == '{'
+               && std::string_view("iUIlL#$").find(data[1]) != std::string_view::npos;
+    }
+}
@@ -0,0 +1,184 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "TileCache.hpp"
+
+#include <algorithm>
+
+namespace GridLib
+{
+    namespace
+    {
+        constexpr size_t MAX_SHARD_COUNT = 16;
+        constexpr size_t MIN_SHARD_CAPACITY = 16 * 1024 * 1024;
+
+        size_t get_byte_size(const TilePtr& tile)
+        {
+            return tile->row_count() * tile->col_count() * sizeof(float);
+        }
+    }
+
+    TileCache::TileCache(size_t capacity)
+    {
+        set_capacity(capacity);
+    }
+
+    size_t TileCache::capacity() const
+    {
+        return capacity_;
+    }
+
+    void TileCache::set_capacity(size_t capacity)
+    {
+        clear();
+        const auto shard_count = std::clamp<size_t>(capacity / MIN_SHARD_CAPACITY,
+                                                    1, MAX_SHARD_COUNT);
+        shards_.clear();
+        for (size_t i = 0; i < shard_count; ++i)
+            shards_.push_back(std::make_unique<Shard>());
+        capacity_ = capacity;
+        shard_capacity_ = capacity / shard_count;
+    }
+
+    bool TileCache::accepts(size_t byte_size) const
+    {
+        return byte_size <= capacity_;
+    }
+
+    TilePtr TileCache::find(size_t key)
+    {
+        auto tile = find(get_shard(key), key);
+        if (!tile && shard_capacity_ < capacity_)
+            tile = find(*large_shard_, key);
+
+        if (tile)
+            ++hits_;
+        else
+            ++misses_;
+        return tile;
+    }
+
+    void TileCache::insert(size_t key, TilePtr tile)
+    {
+        const auto size = get_byte_size(tile);
+        if (!accepts(size))
+            return;
+
+        if (size > shard_capacity_)
+        {
+            insert_large(key, std::move(tile), size);
+            return;
+        }
+
+        {
+            auto& shard = get_shard(key);
+            std::lock_guard lock(shard.mutex);
+            erase(shard, key);
+            evict(shard, size, shard_capacity_);
+            add(shard, key, std::move(tile), size);
+        }
+
+        // Make room in the total capacity by evicting large tiles.
+        if (size_ > capacity_)
+        {
+            std::lock_guard lock(large_shard_->mutex);
+            while (!large_shard_->entries.empty() && size_ > capacity_)
+                evict_last(*large_shard_);
+        }
+    }
+
+    void TileCache::clear()
+    {
+        for (const auto& shard : shards_)
+        {
+            std::lock_guard lock(shard->mutex);
+            while (!shard->entries.empty())
+                evict_last(*shard);
+        }
+
+        std::lock_guard lock(large_shard_->mutex);
+        while (!large_shard_->entries.empty())
+            evict_last(*large_shard_);
+    }
+
+    MultiGridCacheStatistics TileCache::statistics() const
+    {
+        return {hits_, misses_, evictions_, size_, capacity_};
+    }
+
+    TileCache::Shard& TileCache::get_shard(size_t key)
+    {
+        return *shards_[key % shards_.size()];
+    }
+
+    TilePtr TileCache::find(Shard& shard, size_t key)
+    {
+        std::lock_guard lock(shard.mutex);
+        const auto it = shard.index.find(key);
+        if (it == shard.index.end())
+            return {};
+
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return it->second->second;
+    }
+
+    void TileCache::erase(Shard& shard, size_t key)
+    {
+        // Another thread may have loaded the same tile.
+        if (const auto it = shard.index.find(key); it != shard.index.end())
+        {
+            const auto size = get_byte_size(it->second->second);
+            shard.size -= size;
+            size_ -= size;
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+    }
+
+    void TileCache::add(Shard& shard, size_t key, TilePtr tile, size_t size)
+    {
+        shard.entries.emplace_front(key, std::move(tile));
+        shard.index.emplace(key, shard.entries.begin());
+        shard.size += size;
+        size_ += size;
+    }
+
+    void TileCache::insert_large(size_t key, TilePtr tile, size_t size)
+    {
+        // The large shard's lock is always taken before the regular
+        // shards' locks, never after.
+        std::lock_guard lock(large_shard_->mutex);
+        erase(*large_shard_, key);
+        evict(*large_shard_, size, capacity_);
+        for (const auto& shard : shards_)
+        {
+            if (size_ + size <= capacity_)
+                break;
+            std::lock_guard shard_lock(shard->mutex);
+            while (!shard->entries.empty() && size_ + size > capacity_)
+                evict_last(*shard);
+        }
+        add(*large_shard_, key, std::move(tile), size);
+    }
+
+    void TileCache::evict(Shard& shard, size_t required_size, size_t capacity)
+    {
+        while (!shard.entries.empty() && shard.size + required_size > capacity)
+            evict_last(shard);
+    }
+
+    void TileCache::evict_last(Shard& shard)
+    {
+        const auto& [key, tile] = shard.entries.back();
+        const auto size = get_byte_size(tile);
+        shard.size -= size;
+        size_ -= size;
+        shard.index.erase(key);
+        shard.entries.pop_back();
+        ++evictions_;
+    }
+}
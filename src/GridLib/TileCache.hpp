@@ -0,0 +1,103 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <Chorasmia/Array2D.hpp>
+#include "GridLib/MultiGridReader.hpp"
+
+namespace GridLib
+{
+    using TilePtr = std::shared_ptr<const Chorasmia::Array2D<float>>;
+
+    /**
+     * @brief A least-recently-used cache of decoded grids, bounded by the
+     *  number of bytes in the grids' values.
+     *
+     * find() and insert() can be called concurrently. The keys are
+     * distributed over a number of shards that each have their own lock
+     * and an equal part of the capacity, small caches use a single shard.
+     * Tiles that are larger than a shard's capacity are kept in a
+     * separate shard that shares the total capacity with the others.
+     */
+    class TileCache
+    {
+    public:
+        explicit TileCache(size_t capacity = 0);
+
+        [[nodiscard]] size_t capacity() const;
+
+        /**
+         * @brief Sets the cache's capacity and removes all tiles from it.
+         *
+         * Must not be called concurrently with any other member function.
+         */
+        void set_capacity(size_t capacity);
+
+        /**
+         * @brief Returns true if a tile of @a byte_size bytes can be
+         *  added to the cache.
+         */
+        [[nodiscard]] bool accepts(size_t byte_size) const;
+
+        /**
+         * @brief Returns the tile with the given key, or nullptr if the
+         *  cache doesn't contain it.
+         */
+        [[nodiscard]] TilePtr find(size_t key);
+
+        /**
+         * @brief Adds @a tile to the cache, evicting the least recently
+         *  used tiles if necessary.
+         *
+         * Tiles that are larger than the cache's capacity aren't added.
+         */
+        void insert(size_t key, TilePtr tile);
+
+        void clear();
+
+        [[nodiscard]] MultiGridCacheStatistics statistics() const;
+    private:
+        using Entry = std::pair<size_t, TilePtr>;
+
+        struct Shard
+        {
+            std::mutex mutex;
+            std::list<Entry> entries;
+            std::unordered_map<size_t, std::list<Entry>::iterator> index;
+            size_t size = 0;
+        };
+
+        Shard& get_shard(size_t key);
+
+        static TilePtr find(Shard& shard, size_t key);
+
+        void erase(Shard& shard, size_t key);
+
+        void add(Shard& shard, size_t key, TilePtr tile, size_t size);
+
+        void insert_large(size_t key, TilePtr tile, size_t size);
+
+        void evict(Shard& shard, size_t required_size, size_t capacity);
+
+        void evict_last(Shard& shard);
+
+        size_t capacity_ = 0;
+        size_t shard_capacity_ = 0;
+        std::vector<std::unique_ptr<Shard>> shards_;
+        std::unique_ptr<Shard> large_shard_ = std::make_unique<Shard>();
+        std::atomic<size_t> hits_ = 0;
+        std::atomic<size_t> misses_ = 0;
+        std::atomic<size_t> evictions_ = 0;
+        std::atomic<size_t> size_ = 0;
+    };
+}
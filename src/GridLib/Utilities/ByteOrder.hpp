@@ -0,0 +1,65 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace GridLib
+{
+    template <typename T>
+    T byte_swap(T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (size_t i = 0; i < sizeof(T) / 2; ++i)
+            std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Converts between native and little-endian byte order.
+     */
+    template <typename T>
+    T little_endian(T value)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            return value;
+        else
+            return byte_swap(value);
+    }
+
+    /**
+     * @brief Converts between native and big-endian byte order.
+     */
+    template <typename T>
+    T big_endian(T value)
+    {
+        if constexpr (std::endian::native == std::endian::big)
+            return value;
+        else
+            return byte_swap(value);
+    }
+
+    template <typename T>
+    T read_little_endian(const char* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return little_endian(value);
+    }
+
+    template <typename T>
+    T read_big_endian(const char* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return big_endian(value);
+    }
+}
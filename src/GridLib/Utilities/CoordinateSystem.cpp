@@ -24,6 +24,25 @@ namespace GridLib
         }
     }
 
+    int unit_to_epsg_unit(Unit unit)
+    {
+        switch (unit)
+        {
+        case Unit::METER:
+            return 9001;
+        case Unit::FOOT:
+            return 9002;
+        case Unit::US_SURVEY_FOOT:
+            return 9003;
+        case Unit::DEGREE:
+            return 9102;
+        case Unit::ARC_SECOND:
+            return 9104;
+        default:
+            return 0;
+        }
+    }
+
     Unit epsg_crs_to_horizontal_unit(int epsg)
     {
         if (25828 <= epsg && epsg <= 25838)
@@ -16,6 +16,11 @@ namespace GridLib
 
     Unit epsg_unit_to_unit(int epsg);
 
+    /**
+     * @brief Returns the EPSG code of @a unit, or 0 if it has none.
+     */
+    int unit_to_epsg_unit(Unit unit);
+
     Unit epsg_crs_to_horizontal_unit(int epsg);
 
     Unit epsg_crs_to_vertical_unit(int epsg);
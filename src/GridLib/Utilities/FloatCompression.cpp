@@ -0,0 +1,89 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "FloatCompression.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <zlib.h>
+#include "GridLib/GridLibException.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        // Speed matters more than size, the data is read back frequently.
+        constexpr int COMPRESSION_LEVEL = Z_BEST_SPEED;
+
+        void encode(std::span<const float> values, std::vector<uint8_t>& bytes)
+        {
+            const auto n = values.size();
+            bytes.resize(n * 4);
+            uint32_t prev = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                uint32_t value;
+                std::memcpy(&value, &values[i], 4);
+                const auto delta = value - prev;
+                prev = value;
+                bytes[i] = uint8_t(delta);
+                bytes[n + i] = uint8_t(delta >> 8);
+                bytes[2 * n + i] = uint8_t(delta >> 16);
+                bytes[3 * n + i] = uint8_t(delta >> 24);
+            }
+        }
+
+        void decode(std::span<const uint8_t> bytes, std::span<float> values)
+        {
+            const auto n = values.size();
+            uint32_t prev = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto delta = uint32_t(bytes[i])
+                                   | uint32_t(bytes[n + i]) << 8
+                                   | uint32_t(bytes[2 * n + i]) << 16
+                                   | uint32_t(bytes[3 * n + i]) << 24;
+                prev += delta;
+                std::memcpy(&values[i], &prev, 4);
+            }
+        }
+    }
+
+    void compress_floats(std::span<const float> values,
+                         std::vector<char>& output)
+    {
+        thread_local std::vector<uint8_t> bytes;
+        encode(values, bytes);
+
+        auto compressed_size = compressBound(uLong(bytes.size()));
+        const auto offset = output.size();
+        output.resize(offset + compressed_size);
+        const auto result = compress2(
+            reinterpret_cast<Bytef*>(output.data() + offset), &compressed_size,
+            bytes.data(), uLong(bytes.size()), COMPRESSION_LEVEL);
+        if (result != Z_OK)
+            GRIDLIB_THROW("Unable to compress data: error code "
+                          + std::to_string(result));
+        output.resize(offset + compressed_size);
+    }
+
+    void decompress_floats(std::span<const char> data,
+                           std::span<float> values)
+    {
+        thread_local std::vector<uint8_t> bytes;
+        bytes.resize(values.size() * 4);
+
+        auto size = uLongf(bytes.size());
+        const auto result = uncompress(
+            bytes.data(), &size,
+            reinterpret_cast<const Bytef*>(data.data()), uLong(data.size()));
+        if (result != Z_OK || size != bytes.size())
+            GRIDLIB_THROW("Unable to decompress data: error code "
+                          + std::to_string(result));
+        decode(bytes, values);
+    }
+}
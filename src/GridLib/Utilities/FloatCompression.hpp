@@ -0,0 +1,32 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <span>
+#include <vector>
+
+namespace GridLib
+{
+    /**
+     * @brief Compresses @a values and appends the result to @a output.
+     *
+     * The bit patterns of consecutive values are delta encoded and the
+     * bytes of the deltas are grouped by significance (byte-shuffled)
+     * before they are compressed with deflate. Smooth elevation data
+     * typically compresses to a fraction of its original size.
+     */
+    void compress_floats(std::span<const float> values,
+                         std::vector<char>& output);
+
+    /**
+     * @brief Decompresses data produced by compress_floats into @a values.
+     *
+     * @a values must have the same size as the array that was compressed.
+     */
+    void decompress_floats(std::span<const char> data,
+                           std::span<float> values);
+}
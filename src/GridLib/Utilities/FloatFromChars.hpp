@@ -0,0 +1,69 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <charconv>
+#include <type_traits>
+#include <version>
+
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#endif
+
+namespace GridLib
+{
+    /**
+     * @brief Parses a floating point number at the start of
+     *  [@a first, @a last) the same way as std::from_chars.
+     *
+     * Some standard libraries, e.g. older versions of Apple's libc++,
+     * lack std::from_chars for floating point types. There the number
+     * is copied and parsed with strtof or strtod instead.
+     */
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    std::from_chars_result float_from_chars(const char* first, const char* last,
+                                            T& value)
+    {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        return std::from_chars(first, last, value);
+#else
+        // strtod skips leading whitespace, accepts a leading '+' and
+        // hexadecimal numbers, std::from_chars doesn't.
+        constexpr std::string_view NUMBER_CHARS = "0123456789+-.eEinfatyINFATY";
+        if (first == last || *first == '+'
+            || NUMBER_CHARS.find(*first) == std::string_view::npos)
+        {
+            return {first, std::errc::invalid_argument};
+        }
+
+        auto end = first;
+        while (end != last && NUMBER_CHARS.find(*end) != std::string_view::npos)
+            ++end;
+
+        const std::string str(first, end);
+        char* str_end = nullptr;
+        errno = 0;
+        if constexpr (std::is_same_v<T, float>)
+            value = std::strtof(str.c_str(), &str_end);
+        else if constexpr (std::is_same_v<T, double>)
+            value = std::strtod(str.c_str(), &str_end);
+        else
+            value = std::strtold(str.c_str(), &str_end);
+
+        if (str_end == str.c_str())
+            return {first, std::errc::invalid_argument};
+        const auto ptr = first + (str_end - str.c_str());
+        if (errno == ERANGE)
+            return {ptr, std::errc::result_out_of_range};
+        return {ptr, std::errc()};
+#endif
+    }
+}
@@ -0,0 +1,146 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "MemoryMappedFile.hpp"
+
+#include <utility>
+#include "GridLib/GridLibException.hpp"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace GridLib
+{
+    namespace
+    {
+#ifdef _WIN32
+        std::pair<const char*, size_t>
+        map_file(const std::filesystem::path& path)
+        {
+            const auto file = CreateFileW(path.c_str(), GENERIC_READ,
+                                          FILE_SHARE_READ | FILE_SHARE_WRITE
+                                          | FILE_SHARE_DELETE,
+                                          nullptr, OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                GRIDLIB_THROW("Unable to open file: " + path.string());
+
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(file, &file_size))
+            {
+                CloseHandle(file);
+                GRIDLIB_THROW("Unable to get size of file: " + path.string());
+            }
+
+            if (file_size.QuadPart == 0)
+            {
+                CloseHandle(file);
+                return {nullptr, 0};
+            }
+
+            const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY,
+                                                    0, 0, nullptr);
+            CloseHandle(file);
+            if (!mapping)
+                GRIDLIB_THROW("Unable to map file: " + path.string());
+
+            const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (!view)
+                GRIDLIB_THROW("Unable to map file: " + path.string());
+
+            return {static_cast<const char*>(view), size_t(file_size.QuadPart)};
+        }
+
+        void unmap_file(const char* data, size_t)
+        {
+            UnmapViewOfFile(data);
+        }
+#else
+        std::pair<const char*, size_t>
+        map_file(const std::filesystem::path& path)
+        {
+            const int fd = open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+                GRIDLIB_THROW("Unable to open file: " + path.string());
+
+            struct stat st = {};
+            if (fstat(fd, &st) == -1)
+            {
+                ::close(fd);
+                GRIDLIB_THROW("Unable to get size of file: " + path.string());
+            }
+
+            if (st.st_size == 0)
+            {
+                ::close(fd);
+                return {nullptr, 0};
+            }
+
+            const auto size = size_t(st.st_size);
+            void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (data == MAP_FAILED)
+                GRIDLIB_THROW("Unable to map file: " + path.string());
+
+            return {static_cast<const char*>(data), size};
+        }
+
+        void unmap_file(const char* data, size_t size)
+        {
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+    }
+
+    MemoryMappedFile::MemoryMappedFile() = default;
+
+    MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+    {
+        std::tie(data_, size_) = map_file(path);
+    }
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        close();
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        return *this;
+    }
+
+    void MemoryMappedFile::close()
+    {
+        if (data_)
+        {
+            unmap_file(data_, size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+}
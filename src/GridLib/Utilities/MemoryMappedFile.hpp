@@ -0,0 +1,55 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <string_view>
+
+namespace GridLib
+{
+    /**
+     * @brief A read-only memory mapping of an entire file.
+     *
+     * The mapping reflects the file's size at the time it was created.
+     */
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile();
+
+        explicit MemoryMappedFile(const std::filesystem::path& path);
+
+        MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+
+        ~MemoryMappedFile();
+
+        MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+        [[nodiscard]]
+        const char* data() const
+        {
+            return data_;
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return size_;
+        }
+
+        [[nodiscard]]
+        std::string_view view() const
+        {
+            return {data_, size_};
+        }
+
+        void close();
+    private:
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+    };
+}
@@ -0,0 +1,138 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PositionalFileReader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+#include "GridLib/GridLibException.hpp"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace GridLib
+{
+#ifdef _WIN32
+    PositionalFileReader::PositionalFileReader(const std::filesystem::path& path)
+    {
+        const auto file = CreateFileW(path.c_str(), GENERIC_READ,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE
+                                      | FILE_SHARE_DELETE,
+                                      nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            GRIDLIB_THROW("Unable to open file: " + path.string());
+        handle_ = file;
+    }
+
+    bool PositionalFileReader::is_open() const
+    {
+        return handle_ != INVALID_HANDLE;
+    }
+
+    void PositionalFileReader::read(uint64_t offset, void* buffer, size_t size) const
+    {
+        auto* dst = static_cast<char*>(buffer);
+        while (size != 0)
+        {
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = DWORD(offset);
+            overlapped.OffsetHigh = DWORD(offset >> 32);
+            const auto chunk_size = DWORD(std::min<size_t>(size, 1u << 30));
+            DWORD bytes_read = 0;
+            if (!ReadFile(handle_, dst, chunk_size, &bytes_read, &overlapped)
+                || bytes_read == 0)
+            {
+                GRIDLIB_THROW("Unable to read " + std::to_string(size)
+                              + " bytes at offset " + std::to_string(offset));
+            }
+            dst += bytes_read;
+            offset += bytes_read;
+            size -= bytes_read;
+        }
+    }
+
+    void PositionalFileReader::close()
+    {
+        if (handle_ != INVALID_HANDLE)
+        {
+            CloseHandle(handle_);
+            handle_ = INVALID_HANDLE;
+        }
+    }
+#else
+    PositionalFileReader::PositionalFileReader(const std::filesystem::path& path)
+        : handle_(open(path.c_str(), O_RDONLY))
+    {
+        if (handle_ == INVALID_HANDLE)
+            GRIDLIB_THROW("Unable to open file: " + path.string());
+    }
+
+    bool PositionalFileReader::is_open() const
+    {
+        return handle_ != INVALID_HANDLE;
+    }
+
+    void PositionalFileReader::read(uint64_t offset, void* buffer, size_t size) const
+    {
+        auto* dst = static_cast<char*>(buffer);
+        while (size != 0)
+        {
+            const auto bytes_read = pread(handle_, dst, size, off_t(offset));
+            if (bytes_read <= 0)
+            {
+                if (bytes_read == -1 && errno == EINTR)
+                    continue;
+                GRIDLIB_THROW("Unable to read " + std::to_string(size)
+                              + " bytes at offset " + std::to_string(offset));
+            }
+            dst += bytes_read;
+            offset += size_t(bytes_read);
+            size -= size_t(bytes_read);
+        }
+    }
+
+    void PositionalFileReader::close()
+    {
+        if (handle_ != INVALID_HANDLE)
+        {
+            ::close(handle_);
+            handle_ = INVALID_HANDLE;
+        }
+    }
+#endif
+
+    PositionalFileReader::PositionalFileReader() = default;
+
+    PositionalFileReader::PositionalFileReader(PositionalFileReader&& other) noexcept
+        : handle_(std::exchange(other.handle_, INVALID_HANDLE))
+    {
+    }
+
+    PositionalFileReader::~PositionalFileReader()
+    {
+        close();
+    }
+
+    PositionalFileReader&
+    PositionalFileReader::operator=(PositionalFileReader&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        close();
+        handle_ = std::exchange(other.handle_, INVALID_HANDLE);
+        return *this;
+    }
+}
@@ -0,0 +1,54 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <filesystem>
+
+namespace GridLib
+{
+    /**
+     * @brief Reads data at given offsets in a file.
+     *
+     * Reads don't share a file position and can be made concurrently
+     * from several threads.
+     */
+    class PositionalFileReader
+    {
+    public:
+        PositionalFileReader();
+
+        explicit PositionalFileReader(const std::filesystem::path& path);
+
+        PositionalFileReader(PositionalFileReader&& other) noexcept;
+
+        ~PositionalFileReader();
+
+        PositionalFileReader& operator=(PositionalFileReader&& other) noexcept;
+
+        [[nodiscard]] bool is_open() const;
+
+        /**
+         * @brief Reads @a size bytes starting at @a offset into @a buffer.
+         *
+         * Throws GridLibException if fewer than @a size bytes could be
+         * read.
+         */
+        void read(uint64_t offset, void* buffer, size_t size) const;
+
+        void close();
+    private:
+#ifdef _WIN32
+        using Handle = void*;
+        static constexpr Handle INVALID_HANDLE = nullptr;
+#else
+        using Handle = int;
+        static constexpr Handle INVALID_HANDLE = -1;
+#endif
+        Handle handle_ = INVALID_HANDLE;
+    };
+}
@@ -6,68 +6,54 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
-#include <algorithm>
 #include <istream>
 
 namespace GridLib
 {
+    /**
+     * @brief A stream buffer that reads directly from a block of memory.
+     *
+     * The entire block is the buffer's get area, so reads through an
+     * std::istream never call any of the virtual functions below.
+     * read_geotiff uses it to pass in-memory files to Yimage.
+     */
     class ReadOnlyStreamBuffer : public std::basic_streambuf<char>
     {
     public:
         ReadOnlyStreamBuffer(const char* data, size_t size)
-            : data_(data), pos_(0), size_(std::streamsize(size))
         {
+            // basic_streambuf requires non-const pointers, but never
+            // writes through the get area.
+            const auto begin = const_cast<char*>(data);
+            setg(begin, begin, begin + size);
         }
 
     protected:
-        std::streamsize xsgetn(char* ptr, std::streamsize count) final
-        {
-            auto n = std::min(count, size_ - pos_);
-            std::copy(data_ + pos_, data_ + pos_ + n, ptr);
-            pos_ += n;
-            return n;
-        }
-
-        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) final
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode) final
         {
+            const auto size = off_type(egptr() - eback());
+            off_type pos = 0;
             if (dir == std::ios_base::cur)
-            {
-                if (off > size_ - pos_)
-                    pos_ = size_;
-                else if (-off > pos_)
-                    pos_ = 0;
-                else
-                    pos_ += off;
-            }
+                pos = off_type(gptr() - eback());
             else if (dir == std::ios_base::end)
-            {
-                if (off > 0)
-                    pos_ = size_;
-                else if (-off > size_)
-                    pos_ = 0;
-                else
-                    pos_ = size_ + off;
-            }
-            else if (dir == std::ios_base::beg)
-            {
-                if (off < 0)
-                    pos_ = 0;
-                else if (off > size_)
-                    pos_ = size_;
-                else
-                    pos_ = off;
-            }
-            return pos_;
+                pos = size;
+
+            // Positions outside the buffer are moved to its nearest end.
+            if (off > size - pos)
+                pos = size;
+            else if (-off > pos)
+                pos = 0;
+            else
+                pos += off;
+
+            setg(eback(), eback() + pos, egptr());
+            return pos;
         }
 
-        pos_type seekpos(pos_type pos, std::ios_base::openmode) final
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) final
         {
-            pos_ = std::min(std::streamsize(pos), size_);
-            return pos_;
+            return seekoff(off_type(pos), std::ios_base::beg, which);
         }
-
-        const char* data_;
-        std::streamsize pos_;
-        std::streamsize size_;
     };
 }
@@ -0,0 +1,98 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GridLib/WriteBinaryGrid.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <vector>
+#include <Yson/JsonWriter.hpp>
+
+#include "GridLib/GridLibException.hpp"
+#include "GridLib/WriteJsonGrid.hpp"
+#include "BinaryGridFormat.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        template <typename T>
+        void append(std::string& out, T value)
+        {
+            value = little_endian(value);
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        std::string write_model(const SpatialInfo& model)
+        {
+            std::ostringstream stream;
+            {
+                Yson::JsonWriter writer(stream, Yson::JsonFormatting::NONE);
+                writer.setNonFiniteFloatsEnabled(true);
+                write_json(writer, model);
+            }
+            return stream.str();
+        }
+
+        void write_row(std::ostream& stream, std::span<const float> row)
+        {
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                stream.write(reinterpret_cast<const char*>(row.data()),
+                             std::streamsize(row.size() * sizeof(float)));
+            }
+            else
+            {
+                std::vector<float> buffer(row.size());
+                std::ranges::transform(row, buffer.begin(), little_endian<float>);
+                stream.write(reinterpret_cast<const char*>(buffer.data()),
+                             std::streamsize(buffer.size() * sizeof(float)));
+            }
+        }
+    }
+
+    void write_binary_grid(std::ostream& stream, const IGrid& grid)
+    {
+        const auto model = write_model(grid.spatial_info());
+        const auto [rows, cols] = grid.size();
+        const auto header_size = BINARY_GRID_FIXED_HEADER_SIZE + model.size();
+        const auto payload_offset = (header_size + BINARY_GRID_ALIGNMENT - 1)
+                                    / BINARY_GRID_ALIGNMENT
+                                    * BINARY_GRID_ALIGNMENT;
+
+        std::string header(BINARY_GRID_MAGIC);
+        append(header, BINARY_GRID_VERSION);
+        append(header, uint32_t(payload_offset));
+        append(header, uint64_t(rows));
+        append(header, uint64_t(cols));
+        append(header, uint32_t(model.size()));
+        append(header, uint32_t(0));
+        header += model;
+        header.resize(payload_offset, '\0');
+        stream.write(header.data(), std::streamsize(header.size()));
+
+        const auto values = grid.values();
+        for (size_t i = 0; i < values.row_count(); ++i)
+        {
+            const auto row = values.row(i);
+            write_row(stream, std::span(row.begin(), row.size()));
+        }
+    }
+
+    void write_binary_grid(const std::filesystem::path& filename,
+                           const IGrid& grid)
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file)
+            GRIDLIB_THROW("Can not create file: " + filename.string());
+        write_binary_grid(file, grid);
+        if (!file)
+            GRIDLIB_THROW("Error while writing file: " + filename.string());
+    }
+}
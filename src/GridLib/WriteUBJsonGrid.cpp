@@ -0,0 +1,100 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GridLib/WriteUBJsonGrid.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <vector>
+#include <Yson/UBJsonWriter.hpp>
+
+#include "GridLib/GridLibException.hpp"
+#include "GridLib/WriteJsonGrid.hpp"
+#include "Utilities/ByteOrder.hpp"
+
+namespace GridLib
+{
+    namespace
+    {
+        void write_marker(std::ostream& stream, char marker)
+        {
+            stream.put(marker);
+        }
+
+        void write_int64(std::ostream& stream, int64_t value)
+        {
+            write_marker(stream, 'L');
+            value = big_endian(value);
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void write_key(std::ostream& stream, std::string_view key)
+        {
+            write_marker(stream, 'U');
+            stream.put(char(uint8_t(key.size())));
+            stream.write(key.data(), std::streamsize(key.size()));
+        }
+
+        void write_elevations(std::ostream& stream,
+                              const Chorasmia::ArrayView2D<float>& values)
+        {
+            // An array of rows, each of which is an optimized array of
+            // big-endian float32 values: [#L<rows>([$d#L<cols><data>)*
+            write_marker(stream, '[');
+            write_marker(stream, '#');
+            write_int64(stream, int64_t(values.row_count()));
+
+            std::vector<float> buffer(values.col_count());
+            for (size_t i = 0; i < values.row_count(); ++i)
+            {
+                const auto row = values.row(i);
+                write_marker(stream, '[');
+                write_marker(stream, '$');
+                write_marker(stream, 'd');
+                write_marker(stream, '#');
+                write_int64(stream, int64_t(row.size()));
+                const std::span<const float> data(row.begin(), row.size());
+                std::memcpy(buffer.data(), data.data(), data.size_bytes());
+                if constexpr (std::endian::native != std::endian::big)
+                    std::ranges::transform(buffer, buffer.begin(), big_endian<float>);
+                stream.write(reinterpret_cast<const char*>(buffer.data()),
+                             std::streamsize(buffer.size() * sizeof(float)));
+            }
+        }
+    }
+
+    void write_ubjson(std::ostream& stream, const IGrid& grid)
+    {
+        const auto [rows, cols] = grid.size();
+        write_marker(stream, '{');
+        write_key(stream, "row_count");
+        write_int64(stream, int64_t(rows));
+        write_key(stream, "column_count");
+        write_int64(stream, int64_t(cols));
+        write_key(stream, "model");
+        {
+            Yson::UBJsonWriter writer(stream);
+            write_json(writer, grid.spatial_info());
+            writer.flush();
+        }
+        write_key(stream, "elevations");
+        write_elevations(stream, grid.values());
+        write_marker(stream, '}');
+    }
+
+    void write_ubjson(const std::filesystem::path& filename, const IGrid& grid)
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file)
+            GRIDLIB_THROW("Can not create file: " + filename.string());
+        write_ubjson(file, grid);
+        if (!file)
+            GRIDLIB_THROW("Error while writing file: " + filename.string());
+    }
+}
@@ -11,3 +11,7 @@
 extern const std::string_view DEM_FILE;
 extern const std::string_view GEOTIFF_FILE_1;
 extern const std::string_view GEOTIFF_FILE_2;
+extern const std::string_view GEOTIFF_LZMA_FILE;
+extern const std::string_view GEOTIFF_INT16_FILE;
+extern const std::string_view GEOTIFF_UINT16_FILE;
+extern const std::string_view GEOTIFF_FLOAT64_FILE;
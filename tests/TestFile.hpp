@@ -0,0 +1,60 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief A uniquely named file in the temporary directory that is
+ *  removed when the object goes out of scope, even if a test fails.
+ *
+ * The file itself is only created if the test writes to it.
+ */
+class TestFile
+{
+public:
+    explicit TestFile(std::string_view extension)
+        : path_(make_path(extension))
+    {}
+
+    TestFile(std::string_view extension, std::string_view contents)
+        : TestFile(extension)
+    {
+        std::ofstream(path_, std::ios::binary)
+            .write(contents.data(), std::streamsize(contents.size()));
+    }
+
+    TestFile(const TestFile&) = delete;
+
+    TestFile& operator=(const TestFile&) = delete;
+
+    ~TestFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const
+    {
+        return path_;
+    }
+
+private:
+    static std::filesystem::path make_path(std::string_view extension)
+    {
+        static std::mt19937_64 random(std::random_device{}());
+        auto name = "gridlib_test_" + std::to_string(random());
+        name += extension;
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    std::filesystem::path path_;
+};
@@ -5,9 +5,20 @@
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <utility>
 #include <GridLib/MultiGridReader.hpp>
+#include <GridLib/MultiGridTileIterator.hpp>
 #include "TestData.hpp"
+#include "TestFile.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 
@@ -17,7 +28,10 @@ TEST_CASE("Test MultiGridReader")
 {
     using namespace GridLib;
 
-    MultiGridReader reader;
+    const auto storage = GENERATE(MultiGridStorage::TEMPORARY_FILE,
+                                  MultiGridStorage::MEMORY_MAPPED_FILE,
+                                  MultiGridStorage::COMPRESSED_FILE);
+    MultiGridReader reader(storage);
     reader.read_grid(GEOTIFF_FILE_1.data(), GEOTIFF_FILE_1.size(), GridFileType::GEOTIFF);
     reader.read_grid(GEOTIFF_FILE_2.data(), GEOTIFF_FILE_2.size(), GridFileType::GEOTIFF);
 
@@ -37,3 +51,520 @@ TEST_CASE("Test MultiGridReader")
     auto h = grid[{20, 20}];
     REQUIRE_THAT(h, WithinAbs(42.50124f, 0.001f));
 }
+
+TEST_CASE("Test MultiGridReader with many grids")
+{
+    using namespace GridLib;
+
+    constexpr size_t ROWS = 4, COLS = 5, N = 10;
+    auto has_tile = [](size_t i, size_t j) {return (i + j) % 3 != 1;};
+
+    MultiGridReader reader;
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (!has_tile(i, j))
+                continue;
+            Grid grid(Size(ROWS, COLS));
+            grid[{0, 0}] = float(i * N + j);
+            auto& si = grid.spatial_info();
+            si.set_column_axis({1, 0, 0});
+            si.set_row_axis({0, 1, 0});
+            si.set_vertical_axis({0, 0, 1});
+            si.set_location({double(i * ROWS), double(j * COLS), 0});
+            reader.add_grid(grid);
+        }
+    }
+
+    REQUIRE(reader.size() == Size(N * ROWS, N * COLS));
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            const Extent extent({i * ROWS, j * COLS}, {ROWS, COLS});
+            REQUIRE(reader.has_data(extent) == has_tile(i, j));
+            const auto grid = reader.get_grid(extent);
+            if (has_tile(i, j))
+                REQUIRE(grid[{0, 0}] == float(i * N + j));
+            else
+                REQUIRE(grid[{0, 0}] == UNKNOWN_ELEVATION);
+        }
+    }
+}
+
+TEST_CASE("Test MultiGridReader with a small grid followed by a large one")
+{
+    using namespace GridLib;
+
+    auto make_grid = [](const Size& size, const Xyz::Vector3D& location, float value)
+    {
+        Grid grid(size);
+        auto array = grid.values().array();
+        std::fill(array.begin(), array.end(), value);
+        auto& si = grid.spatial_info();
+        si.set_column_axis({1, 0, 0});
+        si.set_row_axis({0, 1, 0});
+        si.set_vertical_axis({0, 0, 1});
+        si.set_location(location);
+        return grid;
+    };
+
+    MultiGridReader reader;
+    reader.add_grid(make_grid({10, 10}, {0, 0, 0}, 1));
+    reader.add_grid(make_grid({1000, 1200}, {20, 0, 0}, 2));
+    reader.add_grid(make_grid({10, 10}, {0, 1190, 0}, 3));
+
+    REQUIRE(reader.size() == Size(1020, 1200));
+    REQUIRE(reader.has_data({{5, 5}, {1, 1}}));
+    REQUIRE(!reader.has_data({{0, 20}, {15, 1000}}));
+    REQUIRE(reader.has_data({{1010, 1190}, {10, 10}}));
+
+    const auto grid = reader.get_grid({{5, 5}, {20, 1190}});
+    REQUIRE(grid[{0, 0}] == 1);
+    REQUIRE(grid[{0, 20}] == UNKNOWN_ELEVATION);
+    REQUIRE(grid[{19, 600}] == 2);
+    REQUIRE(grid[{0, 1186}] == 3);
+}
+
+TEST_CASE("Test MultiGridReader with grids decoded on demand")
+{
+    using namespace GridLib;
+
+    const TestFile file_1(".tif", GEOTIFF_FILE_1);
+    const TestFile file_2(".tif", GEOTIFF_FILE_2);
+    const std::pair<std::filesystem::path, std::string_view> files[] = {
+        {file_1.path(), GEOTIFF_FILE_1},
+        {file_2.path(), GEOTIFF_FILE_2}
+    };
+
+    MultiGridReader expected_reader;
+    MultiGridReader reader(MultiGridStorage::SOURCE_FILES);
+    for (const auto& [path, contents] : files)
+    {
+        expected_reader.read_grid(contents.data(), contents.size(),
+                                  GridFileType::GEOTIFF);
+        reader.read_grid(path);
+    }
+
+    REQUIRE(reader.size() == expected_reader.size());
+    const Extent extent({220, 10}, {40, 500});
+    REQUIRE(reader.get_grid(extent) == expected_reader.get_grid(extent));
+}
+
+TEST_CASE("Test MultiGridReader cache")
+{
+    using namespace GridLib;
+
+    constexpr size_t ROWS = 4, COLS = 5, TILE_BYTES = ROWS * COLS * sizeof(float);
+
+    MultiGridReader reader(MultiGridStorage::TEMPORARY_FILE);
+    reader.set_cache_capacity(2 * TILE_BYTES);
+    REQUIRE(reader.cache_capacity() == 2 * TILE_BYTES);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Grid grid(Size(ROWS, COLS));
+        grid[{0, 0}] = float(i);
+        auto& si = grid.spatial_info();
+        si.set_column_axis({1, 0, 0});
+        si.set_row_axis({0, 1, 0});
+        si.set_vertical_axis({0, 0, 1});
+        si.set_location({double(i * ROWS), 0, 0});
+        reader.add_grid(grid);
+    }
+
+    auto get_value = [&](size_t i)
+    {
+        return reader.get_grid(Extent({i * ROWS, 0}, {ROWS, COLS}))[{0, 0}];
+    };
+
+    REQUIRE(get_value(0) == 0);
+    REQUIRE(get_value(1) == 1);
+    REQUIRE(get_value(0) == 0);
+    auto stats = reader.cache_statistics();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.evictions == 0);
+    REQUIRE(stats.size == 2 * TILE_BYTES);
+
+    // Tile 1 is the least recently used and is evicted.
+    REQUIRE(get_value(2) == 2);
+    REQUIRE(get_value(0) == 0);
+    REQUIRE(get_value(1) == 1);
+    stats = reader.cache_statistics();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 4);
+    REQUIRE(stats.evictions == 2);
+    REQUIRE(stats.size == 2 * TILE_BYTES);
+
+    reader.set_cache_capacity(0);
+    REQUIRE(get_value(1) == 1);
+    stats = reader.cache_statistics();
+    REQUIRE(stats.size == 0);
+    REQUIRE(stats.evictions == 4);
+}
+
+TEST_CASE("Test MultiGridReader cache with a grid larger than a cache shard")
+{
+    using namespace GridLib;
+
+    // Slightly more than 16 MiB, i.e. 1/16 of the cache's capacity.
+    constexpr size_t ROWS = 2100, COLS = 2048;
+
+    MultiGridReader reader(MultiGridStorage::TEMPORARY_FILE);
+    reader.set_cache_capacity(256 * 1024 * 1024);
+
+    Grid grid(Size(ROWS, COLS));
+    grid[{0, 0}] = 1;
+    auto& si = grid.spatial_info();
+    si.set_column_axis({1, 0, 0});
+    si.set_row_axis({0, 1, 0});
+    si.set_vertical_axis({0, 0, 1});
+    reader.add_grid(grid);
+
+    REQUIRE(reader.get_grid(Extent({0, 0}, {2, 2}))[{0, 0}] == 1);
+    REQUIRE(reader.get_grid(Extent({0, 0}, {2, 2}))[{0, 0}] == 1);
+    const auto stats = reader.cache_statistics();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.size == ROWS * COLS * sizeof(float));
+}
+
+TEST_CASE("Test MultiGridReader with concurrent readers")
+{
+    using namespace GridLib;
+
+    constexpr size_t ROWS = 40, COLS = 50, N = 8;
+    constexpr size_t THREADS = 8, ITERATIONS = 200;
+    auto has_tile = [](size_t i, size_t j) {return (i + j) % 3 != 1;};
+    auto get_value = [](size_t i, size_t j, size_t row, size_t col)
+    {
+        return float((i * N + j) * ROWS * COLS + row * COLS + col);
+    };
+
+    const auto storage = GENERATE(MultiGridStorage::TEMPORARY_FILE,
+                                  MultiGridStorage::MEMORY_MAPPED_FILE,
+                                  MultiGridStorage::COMPRESSED_FILE);
+    // 0 disables the cache, the others force frequent evictions.
+    const auto cache_capacity = GENERATE(size_t(0),
+                                         3 * ROWS * COLS * sizeof(float),
+                                         size_t(1) << 20);
+
+    MultiGridReader reader(storage);
+    reader.set_cache_capacity(cache_capacity);
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (!has_tile(i, j))
+                continue;
+            Grid grid(Size(ROWS, COLS));
+            for (size_t row = 0; row < ROWS; ++row)
+            {
+                for (size_t col = 0; col < COLS; ++col)
+                    grid[{row, col}] = get_value(i, j, row, col);
+            }
+            auto& si = grid.spatial_info();
+            si.set_column_axis({1, 0, 0});
+            si.set_row_axis({0, 1, 0});
+            si.set_vertical_axis({0, 0, 1});
+            si.set_location({double(i * ROWS), double(j * COLS), 0});
+            reader.add_grid(grid);
+        }
+    }
+
+    std::atomic<size_t> errors = 0;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            std::mt19937 rng(static_cast<unsigned>(t));
+            std::uniform_int_distribution<size_t> row_dist(0, N * ROWS - 1);
+            std::uniform_int_distribution<size_t> col_dist(0, N * COLS - 1);
+            std::uniform_int_distribution<size_t> size_dist(1, 2 * ROWS);
+            for (size_t k = 0; k < ITERATIONS; ++k)
+            {
+                const Extent extent({row_dist(rng), col_dist(rng)},
+                                    {size_dist(rng), size_dist(rng)});
+                const auto grid = reader.get_grid(extent);
+                const auto [rows, cols] = grid.size();
+                const auto [row0, col0] = extent.origin;
+                for (size_t row = 0; row < rows; ++row)
+                {
+                    for (size_t col = 0; col < cols; ++col)
+                    {
+                        const auto r = row0 + row, c = col0 + col;
+                        const auto i = r / ROWS, j = c / COLS;
+                        const auto expected = has_tile(i, j)
+                            ? get_value(i, j, r % ROWS, c % COLS)
+                            : UNKNOWN_ELEVATION;
+                        if (grid[{row, col}] != expected)
+                            ++errors;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(errors == 0);
+}
+
+TEST_CASE("Test MultiGridReader::read_grids")
+{
+    using namespace GridLib;
+
+    const TestFile file_1(".tif", GEOTIFF_FILE_1);
+    const TestFile file_2(".tif", GEOTIFF_FILE_2);
+    const std::vector<std::filesystem::path> paths = {file_1.path(), file_2.path()};
+
+    const auto storage = GENERATE(MultiGridStorage::MEMORY_MAPPED_FILE,
+                                  MultiGridStorage::SOURCE_FILES);
+
+    SECTION("Same result as read_grid")
+    {
+        MultiGridReader expected_reader(storage);
+        for (const auto& path : paths)
+            expected_reader.read_grid(path);
+
+        MultiGridReader reader(storage);
+        reader.read_grids(paths, 2);
+
+        REQUIRE(reader.size() == expected_reader.size());
+        const Extent extent({220, 10}, {40, 500});
+        REQUIRE(reader.get_grid(extent) == expected_reader.get_grid(extent));
+    }
+
+    SECTION("Error in one of the files")
+    {
+        auto bad_paths = paths;
+        const TestFile missing_file(".tif");
+        bad_paths.insert(bad_paths.begin() + 1, missing_file.path());
+        MultiGridReader reader(storage);
+        REQUIRE_THROWS(reader.read_grids(bad_paths, 2));
+    }
+}
+
+TEST_CASE("Test MultiGridTileIterator")
+{
+    using namespace GridLib;
+
+    constexpr size_t ROWS = 4, COLS = 5;
+
+    // Two grids in opposite corners of a 3x3 arrangement.
+    MultiGridReader reader;
+    for (const auto& [i, j] : {std::pair<size_t, size_t>(0, 0), {2, 2}})
+    {
+        Grid grid(Size(ROWS, COLS));
+        grid[{0, 0}] = float(i);
+        auto& si = grid.spatial_info();
+        si.set_column_axis({1, 0, 0});
+        si.set_row_axis({0, 1, 0});
+        si.set_vertical_axis({0, 0, 1});
+        si.set_location({double(i * ROWS), double(j * COLS), 0});
+        reader.add_grid(grid);
+    }
+    REQUIRE(reader.size() == Size(3 * ROWS, 3 * COLS));
+
+    SECTION("Tiles aligned with the grids")
+    {
+        MultiGridTileIterator it(reader, {ROWS, COLS});
+        REQUIRE(it.tile_count() == 2);
+        REQUIRE(it.next());
+        REQUIRE(it.extent() == Extent({0, 0}, {ROWS, COLS}));
+        REQUIRE(it.grid()[{0, 0}] == 0);
+        REQUIRE(it.next());
+        REQUIRE(it.extent() == Extent({2 * ROWS, 2 * COLS}, {ROWS, COLS}));
+        REQUIRE(it.grid()[{0, 0}] == 2);
+        REQUIRE_FALSE(it.next());
+    }
+
+    SECTION("Tiles that aren't aligned with the grids")
+    {
+        MultiGridTileIterator it(reader, {7, 7});
+        std::vector<Extent> extents;
+        while (it.next())
+        {
+            REQUIRE(reader.has_data(it.extent()));
+            REQUIRE(it.grid().size() == it.extent().size);
+            extents.push_back(it.extent());
+        }
+        REQUIRE(extents == std::vector<Extent>{
+            Extent({0, 0}, {7, 7}),
+            Extent({7, 7}, {5, 7}),
+            Extent({7, 14}, {5, 1})
+        });
+    }
+}
+
+TEST_CASE("Test MultiGridReader::get_grid_into")
+{
+    using namespace GridLib;
+
+    MultiGridReader reader;
+    reader.read_grid(GEOTIFF_FILE_1.data(), GEOTIFF_FILE_1.size(),
+                     GridFileType::GEOTIFF);
+    reader.read_grid(GEOTIFF_FILE_2.data(), GEOTIFF_FILE_2.size(),
+                     GridFileType::GEOTIFF);
+
+    const Extent extent1({220, 10}, {40, 500});
+    const Extent extent2({100, 300}, {40, 500});
+
+    SECTION("Grid")
+    {
+        Grid grid;
+        reader.get_grid_into(extent1, grid);
+        REQUIRE(grid == reader.get_grid(extent1));
+        const auto* data = grid.values().data();
+        reader.get_grid_into(extent2, grid);
+        REQUIRE(grid == reader.get_grid(extent2));
+        REQUIRE(grid.values().data() == data);
+    }
+
+    SECTION("MutableArrayView2D")
+    {
+        Grid buffer(extent1.size);
+        reader.get_grid_into(extent1, buffer.values());
+        const auto expected = reader.get_grid(extent1);
+        REQUIRE(std::as_const(buffer).values() == expected.values());
+        Grid wrong_size(Size(10, 10));
+        REQUIRE_THROWS(reader.get_grid_into(extent1, wrong_size.values()));
+    }
+}
+
+TEST_CASE("Test MultiGridReader merge policies")
+{
+    using namespace GridLib;
+
+    // Two 2x3 grids that overlap in the middle column. The second grid
+    // has an unknown value in its top left corner.
+    MultiGridReader reader;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        Grid grid(Size(2, 3));
+        grid.values().fill(float(10 * (i + 1)));
+        if (i == 1)
+            grid[{0, 0}] = UNKNOWN_ELEVATION;
+        auto& si = grid.spatial_info();
+        si.set_column_axis({1, 0, 0});
+        si.set_row_axis({0, 1, 0});
+        si.set_vertical_axis({0, 0, 1});
+        si.set_location({0, double(2 * i), 0});
+        reader.add_grid(grid);
+    }
+    REQUIRE(reader.size() == Size(2, 5));
+
+    auto get_row = [&](size_t row)
+    {
+        const auto grid = reader.get_grid(Extent({0, 0}, reader.size()));
+        std::vector<float> result;
+        for (size_t col = 0; col < 5; ++col)
+            result.push_back(grid[{row, col}]);
+        return result;
+    };
+
+    REQUIRE(reader.merge_policy() == MultiGridMergePolicy::LAST_WINS);
+    REQUIRE(get_row(0) == std::vector<float>{10, 10, 10, 20, 20});
+    REQUIRE(get_row(1) == std::vector<float>{10, 10, 20, 20, 20});
+
+    reader.set_merge_policy(MultiGridMergePolicy::FIRST_WINS);
+    REQUIRE(get_row(0) == std::vector<float>{10, 10, 10, 20, 20});
+    REQUIRE(get_row(1) == std::vector<float>{10, 10, 10, 20, 20});
+
+    reader.set_merge_policy(MultiGridMergePolicy::MEAN);
+    REQUIRE(get_row(0) == std::vector<float>{10, 10, 10, 20, 20});
+    REQUIRE(get_row(1) == std::vector<float>{10, 10, 15, 20, 20});
+
+    reader.set_merge_policy(MultiGridMergePolicy::MAX);
+    REQUIRE(get_row(0) == std::vector<float>{10, 10, 10, 20, 20});
+    REQUIRE(get_row(1) == std::vector<float>{10, 10, 20, 20, 20});
+}
+
+namespace
+{
+    GridLib::Grid make_smooth_grid(const GridLib::Size& size, size_t i, size_t j)
+    {
+        using namespace GridLib;
+        Grid grid(size);
+        for (size_t row = 0; row < size.rows; ++row)
+        {
+            for (size_t col = 0; col < size.columns; ++col)
+            {
+                const auto x = double(i * size.rows + row);
+                const auto y = double(j * size.columns + col);
+                grid[{row, col}] = float(500 + 100 * std::sin(x / 300)
+                                         + 80 * std::cos(y / 200));
+            }
+        }
+        auto& si = grid.spatial_info();
+        si.set_column_axis({1, 0, 0});
+        si.set_row_axis({0, 1, 0});
+        si.set_vertical_axis({0, 0, 1});
+        si.set_location({double(i * size.rows), double(j * size.columns), 0});
+        return grid;
+    }
+}
+
+TEST_CASE("Test MultiGridReader with compressed storage")
+{
+    using namespace GridLib;
+
+    const Size size(600, 700);
+    MultiGridReader expected_reader(MultiGridStorage::MEMORY_MAPPED_FILE);
+    MultiGridReader reader(MultiGridStorage::COMPRESSED_FILE);
+    reader.set_cache_capacity(GENERATE(size_t(0), size_t(1) << 20));
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const auto grid = make_smooth_grid(size, i, i);
+        expected_reader.add_grid(grid);
+        reader.add_grid(grid);
+    }
+
+    REQUIRE(reader.size() == expected_reader.size());
+    REQUIRE(reader.storage_size() < expected_reader.storage_size());
+
+    for (const auto& extent : {Extent({0, 0}, {1200, 1400}),
+                               Extent({250, 250}, {10, 10}),
+                               Extent({500, 600}, {300, 300}),
+                               Extent({1199, 0}, {1, 1400})})
+    {
+        REQUIRE(reader.get_grid(extent) == expected_reader.get_grid(extent));
+    }
+}
+
+TEST_CASE("Benchmark MultiGridReader storage", "[.][benchmark]")
+{
+    using namespace GridLib;
+
+    const Size size(1000, 1000);
+    const auto storage = GENERATE(MultiGridStorage::TEMPORARY_FILE,
+                                  MultiGridStorage::MEMORY_MAPPED_FILE,
+                                  MultiGridStorage::COMPRESSED_FILE);
+    MultiGridReader reader(storage);
+    reader.set_cache_capacity(0);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+            reader.add_grid(make_smooth_grid(size, i, j));
+    }
+
+    const Extent extent({0, 0}, reader.size());
+    const auto start = std::chrono::steady_clock::now();
+    Grid grid;
+    reader.get_grid_into(extent, grid);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const auto megabytes = double(get_array_size(extent.size) * sizeof(float)) / 1e6;
+    WARN("Storage " << int(storage) << ": " << reader.storage_size()
+         << " bytes on disk, " << megabytes / elapsed.count() << " MB/s");
+
+    BENCHMARK("get_grid_into")
+    {
+        reader.get_grid_into(extent, grid);
+        return grid.size();
+    };
+}
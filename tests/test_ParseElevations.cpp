@@ -0,0 +1,88 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <random>
+#include <string>
+#include <vector>
+#include "GridLib/ParseElevations.hpp"
+#include "GridLib/ParseNumber.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    bool parse_with_parse_number(std::string_view str,
+                                 std::vector<int32_t>& values)
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            auto field = str.substr(i * GridLib::ELEVATION_FIELD_SIZE,
+                                    GridLib::ELEVATION_FIELD_SIZE);
+            field.remove_prefix(std::min(field.find_first_not_of(' '), field.size()));
+            field.remove_suffix(field.size() - (field.find_last_not_of(' ') + 1));
+            if (field.empty() || !GridLib::parse(field, values[i]))
+                return false;
+        }
+        return true;
+    }
+
+    std::string make_field(std::mt19937& rng)
+    {
+        constexpr std::string_view ALPHABET = " -+0123456789_x";
+        std::string field;
+        if (rng() % 4 == 0)
+        {
+            // Random characters, mostly invalid.
+            for (size_t i = 0; i < GridLib::ELEVATION_FIELD_SIZE; ++i)
+                field.push_back(ALPHABET[rng() % ALPHABET.size()]);
+            return field;
+        }
+
+        auto value = int(rng() % 2'000'000) - 999'999;
+        if (rng() % 3 == 0)
+            value %= 100;
+        field = std::to_string(value).substr(0, GridLib::ELEVATION_FIELD_SIZE);
+        field.insert(0, GridLib::ELEVATION_FIELD_SIZE - field.size(), ' ');
+        if (rng() % 20 == 0)
+            field[rng() % field.size()] = ' ';
+        return field;
+    }
+}
+
+TEST_CASE("Test parse_elevations")
+{
+    using GridLib::parse_elevations;
+
+    std::vector<int32_t> values(5);
+    REQUIRE(parse_elevations("     1    -2123456-12345     0", values));
+    REQUIRE(values == std::vector<int32_t>{1, -2, 123456, -12345, 0});
+    REQUIRE(!parse_elevations("     1    -2123456-12345      ", values));
+    REQUIRE(!parse_elevations("     1    -2123 56-12345     0", values));
+}
+
+TEST_CASE("Test parse_elevations against ParseNumber")
+{
+    std::mt19937 rng(1234);
+    for (int i = 0; i < 10'000; ++i)
+    {
+        const size_t count = rng() % 40;
+        std::string str;
+        for (size_t j = 0; j < count; ++j)
+            str += make_field(rng);
+
+        std::vector<int32_t> expected(count);
+        std::vector<int32_t> values(count);
+        const auto expected_ok = parse_with_parse_number(str, expected);
+        INFO(str);
+        REQUIRE(GridLib::parse_elevations(str, values) == expected_ok);
+        if (expected_ok)
+            REQUIRE(values == expected);
+        REQUIRE(GridLib::parse_elevations_scalar(str, values) == expected_ok);
+        if (expected_ok)
+            REQUIRE(values == expected);
+    }
+}
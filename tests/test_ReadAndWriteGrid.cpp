@@ -5,12 +5,22 @@
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
+#include <GridLib/GridLibException.hpp>
+#include <GridLib/ReadBinaryGrid.hpp>
+#include <GridLib/ReadGrid.hpp>
 #include <GridLib/ReadJsonGrid.hpp>
+#include <GridLib/ReadUBJsonGrid.hpp>
+#include <GridLib/WriteBinaryGrid.hpp>
 #include <GridLib/WriteJsonGrid.hpp>
+#include <GridLib/WriteUBJsonGrid.hpp>
+#include <Yson/UBJsonWriter.hpp>
 
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "TestFile.hpp"
 
 TEST_CASE("Test write_json_grid and read_grid")
 {
@@ -44,3 +54,248 @@ TEST_CASE("Test write_json_grid and read_grid")
     auto in_grid = GridLib::read_json_grid(ss, true);
     REQUIRE(grid == in_grid);
 }
+
+namespace
+{
+    GridLib::Grid make_test_grid()
+    {
+        GridLib::Grid grid;
+        grid.resize({6, 8});
+        auto array = grid.values().array();
+        std::iota(array.begin(), array.end(), 0.f);
+        auto& model = grid.spatial_info();
+        model.tie_point = {2, 3};
+        model.crs = {
+            3000, 1000,
+            GridLib::CrsType::PROJECTED, GridLib::CrsLibrary::EPSG,
+            "EPSG:3000"
+        };
+        model.set_location({5000, 7000, 0});
+        model.horizontal_unit = GridLib::Unit::METER;
+        model.vertical_unit = GridLib::Unit::METER;
+        model.set_row_axis({0, -10, 0});
+        model.set_column_axis({10, 0, 0});
+        model.set_vertical_axis({0, 0, 1});
+        std::vector<GridLib::SpatialTiePoint> tie_points;
+        tie_points.push_back({
+            model.tie_point,
+            model.location(),
+            model.crs
+        });
+        model.extra_tie_points = std::move(tie_points);
+        return grid;
+    }
+}
+
+TEST_CASE("Test write_json and read_json_grid from buffer and file")
+{
+    auto grid = make_test_grid();
+    grid.values()[{0, 1}] = GridLib::UNKNOWN_ELEVATION;
+    grid.values()[{1, 2}] = -0.125f;
+    grid.values()[{2, 3}] = 1.5e-7f;
+    grid.values()[{3, 4}] = -3.25e12f;
+    grid.values()[{4, 5}] = 6.02e23f;
+
+    std::stringstream ss;
+    GridLib::write_json(ss, grid);
+    const auto json = ss.str();
+    REQUIRE(json.find("null") != std::string::npos);
+    ss.seekg(0);
+    const auto stream_grid = GridLib::read_json_grid(ss, true);
+    REQUIRE(stream_grid == grid);
+
+    SECTION("Buffer")
+    {
+        auto in_grid = GridLib::read_json_grid(json.data(), json.size(), true);
+        REQUIRE(in_grid == stream_grid);
+    }
+
+    SECTION("File")
+    {
+        const TestFile file(".json");
+        GridLib::write_json(file.path().string(), grid);
+        auto in_grid = GridLib::read_json_grid(file.path(), true);
+        REQUIRE(in_grid == stream_grid);
+    }
+}
+
+TEST_CASE("Test write_ubjson and read_grid")
+{
+    auto grid = make_test_grid();
+    grid.values()[{1, 2}] = GridLib::UNKNOWN_ELEVATION;
+
+    SECTION("Stream")
+    {
+        std::stringstream ss;
+        GridLib::write_ubjson(ss, grid);
+        ss.seekg(0);
+        REQUIRE(GridLib::read_grid(ss, GridLib::GridFileType::GRIDLIB_UBJSON) == grid);
+    }
+
+    SECTION("File")
+    {
+        const TestFile file(".ubj");
+        const auto& path = file.path();
+        GridLib::write_ubjson(path, grid);
+        REQUIRE(GridLib::is_ubjson_grid(path));
+        REQUIRE(GridLib::read_grid(path) == grid);
+
+        auto info = GridLib::read_grid_info(path);
+        REQUIRE(info.size == grid.size());
+        REQUIRE(info.spatial_info == grid.spatial_info());
+    }
+}
+
+TEST_CASE("Test read_ubjson_grid with a grid written by Yson")
+{
+    auto grid = make_test_grid();
+    grid.values()[{1, 2}] = GridLib::UNKNOWN_ELEVATION;
+
+    std::stringstream ss;
+    {
+        Yson::UBJsonWriter writer(ss);
+        GridLib::write_json(writer, grid);
+        writer.flush();
+    }
+    const auto data = ss.str();
+    REQUIRE(GridLib::is_ubjson_grid(data.data(), data.size()));
+
+    SECTION("Buffer")
+    {
+        REQUIRE(GridLib::read_ubjson_grid(data.data(), data.size()) == grid);
+    }
+
+    SECTION("Stream")
+    {
+        ss.seekg(0);
+        REQUIRE(GridLib::read_ubjson_grid(ss) == grid);
+    }
+}
+
+TEST_CASE("Test is_ubjson_grid")
+{
+    REQUIRE(!GridLib::is_ubjson_grid("{}", 2));
+    REQUIRE(!GridLib::is_ubjson_grid("{N}", 3));
+    REQUIRE(!GridLib::is_ubjson_grid("{\"row_count\": 1}", 16));
+    REQUIRE(GridLib::is_ubjson_grid("{i\x09row_count", 12));
+}
+
+TEST_CASE("Test read_json_grid with elevations before the grid size")
+{
+    constexpr std::string_view json = R"({
+        "elevations": [[1, null, 3], [4, 5.5, -6e2]],
+        "row_count": 2,
+        "column_count": 3,
+        "model": {"row_axis": [1, 0, 0], "column_axis": [0, -1, 0]}
+    })";
+    auto grid = GridLib::read_json_grid(json.data(), json.size());
+    REQUIRE(grid.size() == GridLib::Size(2, 3));
+    auto array = grid.values().array();
+    REQUIRE(std::vector(array.begin(), array.end())
+            == std::vector<float>{1, GridLib::UNKNOWN_ELEVATION, 3, 4, 5.5, -600});
+}
+
+TEST_CASE("Benchmark reading JSON grid", "[.][benchmark]")
+{
+    GridLib::Grid grid;
+    grid.resize({4000, 4000});
+    auto array = grid.values().array();
+    for (size_t i = 0; i < array.size(); ++i)
+        array[i] = float(i % 9973) * 0.25f - 500.f;
+    auto& model = grid.spatial_info();
+    model.set_row_axis({1, 0, 0});
+    model.set_column_axis({0, -1, 0});
+    std::stringstream ss;
+    GridLib::write_json(ss, grid);
+    const auto json = ss.str();
+
+    REQUIRE(GridLib::read_json_grid(json.data(), json.size()) == grid);
+
+    BENCHMARK("read_json_grid")
+    {
+        return GridLib::read_json_grid(json.data(), json.size());
+    };
+}
+
+TEST_CASE("Test write_binary_grid and read_grid")
+{
+    auto grid = make_test_grid();
+
+    SECTION("Stream")
+    {
+        std::stringstream ss;
+        GridLib::write_binary_grid(ss, grid);
+        ss.seekg(0);
+        REQUIRE(GridLib::read_binary_grid(ss) == grid);
+    }
+
+    SECTION("File")
+    {
+        const TestFile file(".bin");
+        const auto& path = file.path();
+        GridLib::write_binary_grid(path, grid);
+        REQUIRE(GridLib::read_grid(path) == grid);
+
+        auto info = GridLib::read_grid_info(path);
+        REQUIRE(info.size == grid.size());
+        REQUIRE(info.spatial_info == grid.spatial_info());
+
+        GridLib::MappedGrid mapped(path);
+        REQUIRE(mapped.size() == grid.size());
+        REQUIRE(mapped.spatial_info() == grid.spatial_info());
+        auto values = mapped.values().array();
+        auto expected = grid.values().array();
+        REQUIRE(std::equal(values.begin(), values.end(),
+                           expected.begin(), expected.end()));
+        REQUIRE(mapped.subgrid({1, 2}, {3, 4})[{0, 0}] == 10);
+    }
+}
+
+namespace
+{
+    void require_invalid_binary_grid(const std::string& data)
+    {
+        REQUIRE_THROWS_AS(GridLib::read_binary_grid(data.data(), data.size()),
+                          GridLib::GridLibException);
+
+        std::istringstream stream(data);
+        REQUIRE_THROWS_AS(GridLib::read_binary_grid(stream),
+                          GridLib::GridLibException);
+
+        const TestFile file(".bin", data);
+        REQUIRE_THROWS_AS(GridLib::MappedGrid(file.path()),
+                          GridLib::GridLibException);
+    }
+}
+
+TEST_CASE("Test read_binary_grid with invalid input")
+{
+    std::stringstream ss;
+    GridLib::write_binary_grid(ss, make_test_grid());
+    auto data = ss.str();
+    REQUIRE(data.size() > 64);
+
+    SECTION("Bad magic")
+    {
+        data[0] = 'g';
+        require_invalid_binary_grid(data);
+    }
+
+    SECTION("Unsupported version")
+    {
+        data[8] = char(data[8] + 1);
+        require_invalid_binary_grid(data);
+    }
+
+    SECTION("Unaligned payload offset")
+    {
+        data[12] = char(data[12] + 1);
+        require_invalid_binary_grid(data);
+    }
+
+    SECTION("Truncated payload")
+    {
+        data.resize(data.size() - sizeof(float));
+        require_invalid_binary_grid(data);
+    }
+}
@@ -5,10 +5,14 @@
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
+#include <sstream>
 #include "TestData.hpp"
+#include "TestFile.hpp"
+#include "GridLib/ReadDem.hpp"
 #include "GridLib/ReadGrid.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 TEST_CASE("Read DEM file")
 {
@@ -26,3 +30,48 @@ TEST_CASE("Read DEM file")
     REQUIRE(crs.type == GridLib::CrsType::PROJECTED);
     REQUIRE(crs.library == GridLib::CrsLibrary::EPSG);
 }
+
+TEST_CASE("Read DEM file from buffer and stream")
+{
+    // Buffers are decoded in parallel, streams sequentially.
+    auto buffer_grid = GridLib::read_grid(DEM_FILE.data(), DEM_FILE.size(),
+                                          GridLib::GridFileType::DEM);
+    std::istringstream stream(std::string(DEM_FILE.data(), DEM_FILE.size()));
+    auto stream_grid = GridLib::read_grid(stream, GridLib::GridFileType::DEM);
+    REQUIRE(buffer_grid == stream_grid);
+}
+
+TEST_CASE("Read window of DEM file")
+{
+    auto grid = GridLib::read_dem(DEM_FILE.data(), DEM_FILE.size());
+    const auto window = GridLib::read_dem(DEM_FILE.data(), DEM_FILE.size(),
+                                          GridLib::Extent{{100, 40}, {50, 300}});
+    // The window is clamped to the grid.
+    REQUIRE(window.size() == GridLib::Size(50, 273));
+    REQUIRE(window.values() == grid.subgrid({100, 40}, {50, 273}).values());
+
+    const auto& si = grid.spatial_info();
+    const auto expected_location = si.location()
+                                   + 100.0 * si.column_axis()
+                                   + 40.0 * si.row_axis();
+    REQUIRE(Xyz::are_equal(window.spatial_info().location(), expected_location));
+}
+
+TEST_CASE("Read DEM file info")
+{
+    const TestFile file(".dem", DEM_FILE);
+    auto info = GridLib::read_grid_info(file.path());
+    auto grid = GridLib::read_grid(file.path());
+
+    REQUIRE(info.size == grid.size());
+    REQUIRE(info.spatial_info == grid.spatial_info());
+}
+
+TEST_CASE("Benchmark reading DEM file", "[.][benchmark]")
+{
+    BENCHMARK("read_grid")
+    {
+        return GridLib::read_grid(DEM_FILE.data(), DEM_FILE.size(),
+                                  GridLib::GridFileType::DEM);
+    };
+}
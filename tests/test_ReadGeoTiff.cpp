@@ -5,10 +5,14 @@
 // This file is distributed under the Zero-Clause BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
+#include <vector>
 #include "TestData.hpp"
+#include "TestFile.hpp"
+#include "GridLib/ReadGeoTiff.hpp"
 #include "GridLib/ReadGrid.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 TEST_CASE("Read GeoTIFF file")
 {
@@ -25,3 +29,111 @@ TEST_CASE("Read GeoTIFF file")
     REQUIRE(crs.library == GridLib::CrsLibrary::EPSG);
     REQUIRE(crs.citation.starts_with("ESRI PE"));
 }
+
+TEST_CASE("Read window of GeoTIFF file")
+{
+    auto grid = GridLib::read_geotiff(GEOTIFF_FILE_1.data(), GEOTIFF_FILE_1.size());
+    const auto window = GridLib::read_geotiff(GEOTIFF_FILE_1.data(), GEOTIFF_FILE_1.size(),
+                                              GridLib::Extent{{10, 30}, {20, 100}});
+    // The window is clamped to the grid.
+    REQUIRE(window.size() == GridLib::Size(20, 50));
+    REQUIRE(window.values() == grid.subgrid({10, 30}, {20, 50}).values());
+
+    const auto& si = grid.spatial_info();
+    const auto expected_location = si.location()
+                                   + 10.0 * si.column_axis()
+                                   + 30.0 * si.row_axis();
+    REQUIRE(Xyz::are_equal(window.spatial_info().location(), expected_location));
+}
+
+TEST_CASE("Read LZMA compressed GeoTIFF file")
+{
+    // The direct decoder doesn't support LZMA, so this file is read with
+    // Yimage instead. It has the same raster as GEOTIFF_FILE_1.
+    const auto expected = GridLib::read_geotiff(GEOTIFF_FILE_1.data(), GEOTIFF_FILE_1.size());
+    const auto grid = GridLib::read_geotiff(GEOTIFF_LZMA_FILE.data(), GEOTIFF_LZMA_FILE.size());
+    REQUIRE(grid.size() == expected.size());
+    REQUIRE(grid.values() == expected.values());
+    REQUIRE(grid.spatial_info() == expected.spatial_info());
+
+    const auto window = GridLib::read_geotiff(GEOTIFF_LZMA_FILE.data(), GEOTIFF_LZMA_FILE.size(),
+                                              GridLib::Extent{{10, 30}, {20, 100}});
+    REQUIRE(window.size() == GridLib::Size(20, 50));
+    REQUIRE(window.values() == expected.subgrid({10, 30}, {20, 50}).values());
+}
+
+namespace
+{
+    std::vector<float> read_values(std::string_view file)
+    {
+        const auto grid = GridLib::read_geotiff(file.data(), file.size());
+        const auto values = grid.values().array();
+        return {values.begin(), values.end()};
+    }
+}
+
+TEST_CASE("Read int16 GeoTIFF with scale, offset and no-data value")
+{
+    // The GDAL metadata also has a scale for sample 1, which must be
+    // ignored.
+    auto scaled = [](int v) {return float(v * 0.1 + 100.0);};
+    constexpr auto UNKNOWN = GridLib::UNKNOWN_ELEVATION;
+    REQUIRE(read_values(GEOTIFF_INT16_FILE) == std::vector<float>{
+                scaled(-500), scaled(-250), scaled(0), scaled(250),
+                scaled(500), UNKNOWN, scaled(1000), scaled(1234),
+                scaled(-1), scaled(1), scaled(32767), scaled(-32767)
+            });
+}
+
+TEST_CASE("Read uint16 GeoTIFF with interleaved samples")
+{
+    // The second sample is 9999 in every pixel, only the first is read.
+    auto scaled = [](int v) {return float(v * 0.01 - 10.0);};
+    REQUIRE(read_values(GEOTIFF_UINT16_FILE) == std::vector<float>{
+                scaled(0), scaled(1), scaled(65535),
+                scaled(40000), scaled(123), scaled(7)
+            });
+}
+
+TEST_CASE("Read float64 GeoTIFF with separate planes")
+{
+    // The second band is 77 everywhere, only the first is read. The
+    // no-data value is -9999.
+    constexpr auto UNKNOWN = GridLib::UNKNOWN_ELEVATION;
+    REQUIRE(read_values(GEOTIFF_FLOAT64_FILE) == std::vector<float>{
+                1.5f, -2.25f, UNKNOWN, 1e6f,
+                0.125f, UNKNOWN, float(3e-3), -0.5f
+            });
+
+    const auto window = GridLib::read_geotiff(GEOTIFF_FLOAT64_FILE.data(),
+                                              GEOTIFF_FLOAT64_FILE.size(),
+                                              GridLib::Extent{{1, 2}, {1, 2}});
+    REQUIRE(window.size() == GridLib::Size(1, 2));
+    REQUIRE(window[{0, 0}] == float(3e-3));
+    REQUIRE(window[{0, 1}] == -0.5f);
+}
+
+TEST_CASE("Read GeoTIFF file info")
+{
+    const TestFile file(".tif", GEOTIFF_FILE_1);
+    auto info = GridLib::read_grid_info(file.path());
+    auto grid = GridLib::read_grid(file.path());
+
+    REQUIRE(info.size == grid.size());
+    REQUIRE(info.spatial_info == grid.spatial_info());
+}
+
+TEST_CASE("Benchmark reading GeoTIFF file", "[.][benchmark]")
+{
+    BENCHMARK("read_grid, direct decoder")
+    {
+        return GridLib::read_grid(GEOTIFF_FILE_1.data(), GEOTIFF_FILE_1.size(),
+                                  GridLib::GridFileType::GEOTIFF);
+    };
+
+    BENCHMARK("read_grid, LZMA through Yimage")
+    {
+        return GridLib::read_grid(GEOTIFF_LZMA_FILE.data(), GEOTIFF_LZMA_FILE.size(),
+                                  GridLib::GridFileType::GEOTIFF);
+    };
+}
@@ -0,0 +1,115 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <istream>
+#include <string_view>
+#include "GridLib/Utilities/ReadOnlyStreamBuffer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    constexpr std::string_view DATA = "0123456789";
+}
+
+TEST_CASE("ReadOnlyStreamBuffer get, peek and read")
+{
+    GridLib::ReadOnlyStreamBuffer buffer(DATA.data(), DATA.size());
+    std::istream stream(&buffer);
+    REQUIRE(buffer.in_avail() == 10);
+
+    REQUIRE(stream.peek() == '0');
+    REQUIRE(stream.get() == '0');
+    REQUIRE(stream.get() == '1');
+    REQUIRE(buffer.in_avail() == 8);
+
+    char chars[4];
+    REQUIRE(stream.read(chars, 4));
+    REQUIRE(std::string_view(chars, 4) == "2345");
+    REQUIRE(buffer.in_avail() == 4);
+
+    char rest[8];
+    stream.read(rest, 8);
+    REQUIRE(stream.gcount() == 4);
+    REQUIRE(std::string_view(rest, 4) == "6789");
+    REQUIRE(stream.eof());
+    REQUIRE(buffer.in_avail() == 0);
+
+    stream.clear();
+    REQUIRE(stream.peek() == std::istream::traits_type::eof());
+    stream.clear();
+    REQUIRE(stream.get() == std::istream::traits_type::eof());
+}
+
+TEST_CASE("ReadOnlyStreamBuffer seekg and tellg")
+{
+    GridLib::ReadOnlyStreamBuffer buffer(DATA.data(), DATA.size());
+    std::istream stream(&buffer);
+
+    SECTION("From the beginning")
+    {
+        REQUIRE(stream.seekg(3, std::ios::beg));
+        REQUIRE(stream.tellg() == 3);
+        REQUIRE(stream.get() == '3');
+        REQUIRE(buffer.in_avail() == 6);
+    }
+
+    SECTION("From the current position")
+    {
+        stream.seekg(5);
+        REQUIRE(stream.seekg(2, std::ios::cur));
+        REQUIRE(stream.tellg() == 7);
+        REQUIRE(stream.seekg(-4, std::ios::cur));
+        REQUIRE(stream.tellg() == 3);
+        REQUIRE(stream.get() == '3');
+    }
+
+    SECTION("From the end")
+    {
+        REQUIRE(stream.seekg(-2, std::ios::end));
+        REQUIRE(stream.tellg() == 8);
+        REQUIRE(stream.get() == '8');
+        REQUIRE(stream.seekg(0, std::ios::end));
+        REQUIRE(stream.tellg() == 10);
+        REQUIRE(buffer.in_avail() == 0);
+    }
+
+    SECTION("Offsets past the end are clamped to the end")
+    {
+        REQUIRE(stream.seekg(25, std::ios::beg));
+        REQUIRE(stream.tellg() == 10);
+        stream.seekg(4);
+        REQUIRE(stream.seekg(7, std::ios::cur));
+        REQUIRE(stream.tellg() == 10);
+        REQUIRE(stream.seekg(3, std::ios::end));
+        REQUIRE(stream.tellg() == 10);
+        REQUIRE(stream.get() == std::istream::traits_type::eof());
+    }
+
+    SECTION("Offsets before the beginning are clamped to the beginning")
+    {
+        REQUIRE(stream.seekg(-3, std::ios::beg));
+        REQUIRE(stream.tellg() == 0);
+        stream.seekg(4);
+        REQUIRE(stream.seekg(-7, std::ios::cur));
+        REQUIRE(stream.tellg() == 0);
+        REQUIRE(stream.seekg(-25, std::ios::end));
+        REQUIRE(stream.tellg() == 0);
+        REQUIRE(stream.get() == '0');
+    }
+
+    SECTION("Seeking after reading past the end")
+    {
+        char chars[16];
+        stream.read(chars, 16);
+        REQUIRE(stream.eof());
+        stream.clear();
+        REQUIRE(stream.seekg(1));
+        REQUIRE(stream.tellg() == 1);
+        REQUIRE(stream.get() == '1');
+    }
+}
@@ -0,0 +1,99 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-17.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <numeric>
+#include "TestData.hpp"
+#include "TestFile.hpp"
+#include "GridLib/ReadGeoTiff.hpp"
+#include "GridLib/WriteGeoTiff.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    GridLib::Grid write_and_read(const GridLib::IGrid& grid,
+                                 const GridLib::GeoTiffWriteOptions& options)
+    {
+        const TestFile file(".tif");
+        GridLib::write_geotiff(file.path(), grid, options);
+        return GridLib::read_geotiff(file.path());
+    }
+}
+
+TEST_CASE("Write and read GeoTIFF file")
+{
+    auto grid = GridLib::read_geotiff(GEOTIFF_FILE_1.data(), GEOTIFF_FILE_1.size());
+
+    SECTION("Tiled, deflate and predictor")
+    {
+        REQUIRE(write_and_read(grid, {}) == grid);
+    }
+
+    SECTION("Small tiles without predictor")
+    {
+        GridLib::GeoTiffWriteOptions options;
+        options.tile_size = 16;
+        options.predictor = false;
+        REQUIRE(write_and_read(grid, options) == grid);
+    }
+
+    SECTION("Uncompressed strips")
+    {
+        GridLib::GeoTiffWriteOptions options;
+        options.tile_size = 0;
+        options.compression = GridLib::GeoTiffCompression::NONE;
+        options.predictor = false;
+        REQUIRE(write_and_read(grid, options) == grid);
+    }
+}
+
+TEST_CASE("Write and read rotated grid as GeoTIFF")
+{
+    GridLib::Grid grid;
+    grid.resize({37, 53});
+    auto array = grid.values().array();
+    std::iota(array.begin(), array.end(), 0.f);
+    array[5] = GridLib::UNKNOWN_ELEVATION;
+    auto& model = grid.spatial_info();
+    model.crs = {
+        25832, 5941,
+        GridLib::CrsType::PROJECTED, GridLib::CrsLibrary::EPSG,
+        "ETRS89 / UTM zone 32N"
+    };
+    model.set_location({500000, 6000000, 0});
+    model.horizontal_unit = GridLib::Unit::METER;
+    model.vertical_unit = GridLib::Unit::METER;
+    model.set_row_axis({0, 30, 0});
+    model.set_column_axis({30, 0, 0});
+    model.set_vertical_axis({0, 0, 0.1});
+    model.extra_tie_points = {{model.tie_point, model.location(), model.crs}};
+
+    REQUIRE(write_and_read(grid, {}) == grid);
+}
+
+TEST_CASE("Write and read GeoTIFF with CRS codes that don't fit in a geo key")
+{
+    GridLib::Grid grid;
+    grid.resize({20, 30});
+    auto array = grid.values().array();
+    std::iota(array.begin(), array.end(), 0.f);
+    auto& model = grid.spatial_info();
+    model.crs = {
+        102100, 105700,
+        GridLib::CrsType::PROJECTED, GridLib::CrsLibrary::EPSG,
+        "WGS 84 / Pseudo-Mercator"
+    };
+    model.set_location({1000000, 8000000, 0});
+    model.horizontal_unit = GridLib::Unit::METER;
+    model.vertical_unit = GridLib::Unit::METER;
+    model.set_row_axis({10, 0, 0});
+    model.set_column_axis({0, -10, 0});
+    model.set_vertical_axis({0, 0, 1});
+    model.extra_tie_points = {{model.tie_point, model.location(), model.crs}};
+
+    REQUIRE(write_and_read(grid, {}) == grid);
+}